@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FlatHashMap.hpp>
+#include <SFML/System/Clock.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Glyph keys, as used by the glyph atlases of sf::Font: character size,
+    // and combination of outline thickness, bold flag and code point
+    typedef std::pair<unsigned int, sf::Uint64> Key;
+
+    // Number of lookups measured
+    const std::size_t lookupCount = 30000000;
+
+    ////////////////////////////////////////////////////////////
+    // Build the 300 keys of 3 character sizes, 2 styles and
+    // 50 code points, like a screen of text would use
+    ////////////////////////////////////////////////////////////
+    std::vector<Key> createKeys()
+    {
+        const unsigned int sizes[3] = {14, 20, 32};
+
+        std::vector<Key> keys;
+        for (int size = 0; size < 3; ++size)
+            for (sf::Uint64 bold = 0; bold < 2; ++bold)
+                for (sf::Uint64 codePoint = 0x41; codePoint < 0x41 + 50; ++codePoint)
+                    keys.push_back(Key(sizes[size], (bold << 31) | codePoint));
+
+        return keys;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Look up the keys in a random order, and return the duration
+    // (the sum of the values found is returned, so that the
+    // lookups can't be optimized away)
+    ////////////////////////////////////////////////////////////
+    template <typename Lookup>
+    sf::Time measure(const std::vector<Key>& keys, const std::vector<sf::Uint32>& order, Lookup lookup, sf::Uint64& sum)
+    {
+        sf::Clock clock;
+
+        sum = 0;
+        for (std::size_t i = 0; i < lookupCount; ++i)
+            sum += lookup(keys[order[i % order.size()]]);
+
+        return clock.getElapsedTime();
+    }
+
+    // Lookup in a std::map, as the atlases did before
+    struct MapLookup
+    {
+        const std::map<Key, sf::Uint32>* map;
+
+        sf::Uint32 operator ()(const Key& key) const
+        {
+            std::map<Key, sf::Uint32>::const_iterator it = map->find(key);
+            return (it != map->end()) ? it->second : 0;
+        }
+    };
+
+    // Lookup in the flat hash table used by the atlases
+    struct FlatLookup
+    {
+        sf::priv::FlatHashMap<Key, sf::Uint32>* map;
+
+        sf::Uint32 operator ()(const Key& key) const
+        {
+            const sf::Uint32* value = map->find(key);
+            return value ? *value : 0;
+        }
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Compares the glyph lookups of std::map and of the flat
+/// hash table which sf::Font uses to index its glyphs.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<Key> keys = createKeys();
+
+    std::map<Key, sf::Uint32> map;
+    sf::priv::FlatHashMap<Key, sf::Uint32> flat;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        map[keys[i]] = static_cast<sf::Uint32>(i);
+        flat.insert(keys[i], static_cast<sf::Uint32>(i));
+    }
+
+    // Random order of access, long enough not to be learned by the branch predictor
+    std::vector<sf::Uint32> order(65536);
+    std::srand(42);
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = static_cast<sf::Uint32>(std::rand() % keys.size());
+
+    MapLookup mapLookup = {&map};
+    FlatLookup flatLookup = {&flat};
+
+    sf::Uint64 mapSum = 0;
+    sf::Uint64 flatSum = 0;
+    sf::Time mapTime = measure(keys, order, mapLookup, mapSum);
+    sf::Time flatTime = measure(keys, order, flatLookup, flatSum);
+
+    std::cout << lookupCount << " lookups over " << keys.size() << " glyph keys" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "std::map          " << mapTime.asSeconds() << " s" << std::endl;
+    std::cout << "priv::FlatHashMap " << flatTime.asSeconds() << " s" << std::endl;
+
+    if (mapSum != flatSum)
+    {
+        std::cout << "The tables returned different values" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
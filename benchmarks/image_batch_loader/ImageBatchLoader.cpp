@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+    // Images decoded by each measure
+    const unsigned int imageCount = 32;
+    const unsigned int imageSize  = 512;
+
+    ////////////////////////////////////////////////////////////
+    // Encode the test images: gradients with some noise, so that
+    // they compress like photos rather than like flat colors
+    ////////////////////////////////////////////////////////////
+    void createImages(const std::string& format, std::vector<std::vector<sf::Uint8> >& files)
+    {
+        files.resize(imageCount);
+        for (unsigned int i = 0; i < imageCount; ++i)
+        {
+            sf::Image image;
+            image.create(imageSize, imageSize);
+            for (unsigned int y = 0; y < imageSize; ++y)
+            {
+                for (unsigned int x = 0; x < imageSize; ++x)
+                {
+                    sf::Uint8 noise = static_cast<sf::Uint8>(std::rand() % 16);
+                    image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x / 2 + noise),
+                                                   static_cast<sf::Uint8>(y / 2 + noise),
+                                                   static_cast<sf::Uint8>(i * 8 + noise)));
+                }
+            }
+
+            image.saveToMemory(files[i], format);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Decode all the images one after the other (into separate
+    // images, since the batch loader keeps them all as well)
+    ////////////////////////////////////////////////////////////
+    sf::Time loadSerial(const std::vector<std::vector<sf::Uint8> >& files)
+    {
+        sf::Clock clock;
+
+        std::vector<sf::Image> images(files.size());
+        for (std::size_t i = 0; i < files.size(); ++i)
+            images[i].loadFromMemory(&files[i][0], files[i].size());
+
+        return clock.getElapsedTime();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Decode all the images with an image batch loader
+    ////////////////////////////////////////////////////////////
+    sf::Time loadBatch(const std::vector<std::vector<sf::Uint8> >& files, unsigned int threadCount)
+    {
+        sf::Clock clock;
+
+        sf::ImageBatchLoader loader;
+        for (std::size_t i = 0; i < files.size(); ++i)
+            loader.add(&files[i][0], files[i].size());
+
+        loader.launch(threadCount);
+        loader.wait();
+
+        return clock.getElapsedTime();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Print a line of results
+    ////////////////////////////////////////////////////////////
+    void report(const std::string& name, sf::Time time, sf::Time serial)
+    {
+        double megapixels = static_cast<double>(imageCount) * imageSize * imageSize / 1000000.0;
+
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(1) << time.asSeconds() * 1000.f << " ms"
+                  << std::setw(10) << std::setprecision(1) << megapixels / time.asSeconds() << " MP/s"
+                  << std::setw(8)  << std::setprecision(2) << serial.asSeconds() / time.asSeconds() << "x" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Compares the decoding of a set of images one after the
+/// other with sf::Image, and in parallel with
+/// sf::ImageBatchLoader using different numbers of threads.
+/// The images are encoded in memory first, so that only the
+/// decoding is measured.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    const char* formats[] = {"png", "jpg"};
+    const unsigned int threadCounts[] = {1, 2, 4, 8};
+
+    for (std::size_t f = 0; f < sizeof(formats) / sizeof(*formats); ++f)
+    {
+        std::vector<std::vector<sf::Uint8> > files;
+        createImages(formats[f], files);
+
+        std::cout << imageCount << " " << formats[f] << " images of " << imageSize << "x" << imageSize << std::endl;
+
+        // Warm up the caches and the allocator
+        loadSerial(files);
+
+        sf::Time serial = loadSerial(files);
+        report("sf::Image", serial, serial);
+
+        for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(*threadCounts); ++t)
+        {
+            std::ostringstream name;
+            name << "batch, " << threadCounts[t] << " thread" << (threadCounts[t] > 1 ? "s" : "");
+            report(name.str(), loadBatch(files, threadCounts[t]), serial);
+        }
+
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Size of the rows processed by the kernels, in pixels (a 1024x1024 image)
+    const std::size_t pixelCount = 1024 * 1024;
+
+    // Minimum duration of each measure
+    const sf::Time minimumDuration = sf::milliseconds(300);
+
+    // Pixels of the source, the destination and a copy of the destination
+    std::vector<sf::Uint8> source(pixelCount * 4);
+    std::vector<sf::Uint8> destination(pixelCount * 4);
+    std::vector<sf::Uint8> reference(pixelCount * 4);
+    sf::Uint8 table[256];
+
+    ////////////////////////////////////////////////////////////
+    // Scalar versions, as the loops of sf::Image were written
+    // before they were vectorized
+    ////////////////////////////////////////////////////////////
+    void blendScalar(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+        {
+            sf::Uint8 alpha = src[3];
+            dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+            dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+            dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+            dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+        }
+    }
+
+    void maskScalar(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        for (std::size_t i = 0; i < count; ++i, pixels += 4)
+        {
+            if ((pixels[0] == color[0]) && (pixels[1] == color[1]) && (pixels[2] == color[2]) && (pixels[3] == color[3]))
+                pixels[3] = alpha;
+        }
+    }
+
+    void reverseScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        sf::Uint8* left  = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 8)
+        {
+            right -= 4;
+            std::swap_ranges(left, left + 4, right);
+            left += 4;
+        }
+    }
+
+    void premultiplyScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i, pixels += 4)
+        {
+            pixels[0] = (pixels[0] * pixels[3] + 127) / 255;
+            pixels[1] = (pixels[1] * pixels[3] + 127) / 255;
+            pixels[2] = (pixels[2] * pixels[3] + 127) / 255;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Kernels measured, with a common signature; they all
+    // work on the destination pixels
+    ////////////////////////////////////////////////////////////
+    const sf::Uint8 maskColor[4] = {10, 20, 30, 255};
+
+    void runBlendScalar()       {blendScalar(&source[0], &destination[0], pixelCount);}
+    void runBlend()             {sf::priv::blendPixels(&source[0], &destination[0], pixelCount);}
+    void runMaskScalar()        {maskScalar(&destination[0], pixelCount, maskColor, 0);}
+    void runMask()              {sf::priv::maskPixels(&destination[0], pixelCount, maskColor, 0);}
+    void runReverseScalar()     {reverseScalar(&destination[0], pixelCount);}
+    void runReverse()           {sf::priv::reversePixels(&destination[0], pixelCount);}
+    void runSwapScalar()        {std::swap_ranges(&destination[0], &destination[0] + pixelCount * 2, &destination[0] + pixelCount * 2);}
+    void runSwap()              {sf::priv::swapBytes(&destination[0], &destination[0] + pixelCount * 2, pixelCount * 2);}
+    void runPremultiplyScalar() {premultiplyScalar(&destination[0], pixelCount);}
+    void runPremultiply()       {sf::priv::premultiplyPixels(&destination[0], pixelCount);}
+    void runUnpremultiply()     {sf::priv::unpremultiplyPixels(&destination[0], pixelCount);}
+    void runMapComponents()     {sf::priv::mapColorComponents(&destination[0], pixelCount, table);}
+
+    typedef void (*Kernel)();
+
+    ////////////////////////////////////////////////////////////
+    // Fill the pixels with random values; some pixels are given
+    // the mask color, and the alpha values cover the special cases
+    ////////////////////////////////////////////////////////////
+    void resetPixels()
+    {
+        std::srand(42);
+        for (std::size_t i = 0; i < pixelCount * 4; ++i)
+        {
+            source[i]      = static_cast<sf::Uint8>(std::rand());
+            destination[i] = static_cast<sf::Uint8>(std::rand());
+        }
+
+        for (std::size_t i = 0; i < pixelCount; i += 7)
+        {
+            std::memcpy(&destination[i * 4], maskColor, 4);
+            source[i * 4 + 3] = (i % 2) ? 0 : 255;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Measure a kernel, in millions of pixels per second, and
+    // check that it gives the same result as the reference
+    ////////////////////////////////////////////////////////////
+    double measure(Kernel kernel, bool& matches)
+    {
+        // Check the result of a single run
+        resetPixels();
+        kernel();
+        matches = reference.empty() || (destination == reference);
+        if (reference.empty())
+            reference = destination;
+
+        // Run the kernel repeatedly
+        resetPixels();
+        sf::Clock clock;
+        std::size_t runs = 0;
+        do
+        {
+            kernel();
+            runs++;
+        }
+        while (clock.getElapsedTime() < minimumDuration);
+
+        return runs * static_cast<double>(pixelCount) / clock.getElapsedTime().asMicroseconds();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Print the speed of the code paths of a kernel
+    ////////////////////////////////////////////////////////////
+    void compare(const char* name, Kernel scalar, Kernel kernel)
+    {
+        reference.clear();
+
+        std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(0);
+
+        bool matches = true;
+        if (scalar)
+            std::cout << std::setw(12) << measure(scalar, matches);
+        else
+            std::cout << std::setw(12) << "-";
+
+        sf::priv::setAvx2Enabled(false);
+        bool vectorMatches = true;
+        std::cout << std::setw(12) << measure(kernel, vectorMatches);
+
+        bool avx2Matches = true;
+        sf::priv::setAvx2Enabled(true);
+        if (sf::priv::isAvx2Enabled())
+            std::cout << std::setw(12) << measure(kernel, avx2Matches);
+        else
+            std::cout << std::setw(12) << "-";
+
+        if (!vectorMatches || !avx2Matches)
+            std::cout << "  MISMATCH";
+
+        std::cout << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Measures the pixel kernels of sf::Image with each of their
+/// code paths: the scalar loops they replaced, the version
+/// selected at compile time (SSE2, NEON or scalar), and the
+/// AVX2 version when the CPU supports it.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    for (int i = 0; i < 256; ++i)
+        table[i] = static_cast<sf::Uint8>(255 - i);
+
+    sf::priv::setAvx2Enabled(true);
+    std::cout << "AVX2 " << (sf::priv::isAvx2Enabled() ? "supported" : "not supported") << std::endl;
+    std::cout << "Speed in millions of pixels per second, on rows of " << pixelCount << " pixels" << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(24) << "Kernel" << std::right
+              << std::setw(12) << "scalar" << std::setw(12) << "compiled" << std::setw(12) << "AVX2" << std::endl;
+
+    compare("blendPixels",         &runBlendScalar,       &runBlend);
+    compare("maskPixels",          &runMaskScalar,        &runMask);
+    compare("reversePixels",       &runReverseScalar,     &runReverse);
+    compare("swapBytes",           &runSwapScalar,        &runSwap);
+    compare("premultiplyPixels",   &runPremultiplyScalar, &runPremultiply);
+    compare("unpremultiplyPixels", NULL,                  &runUnpremultiply);
+    compare("mapColorComponents",  NULL,                  &runMapComponents);
+
+    return EXIT_SUCCESS;
+}
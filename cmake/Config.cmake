@@ -113,6 +113,16 @@ else()
     return()
 endif()
 
+# detect the flags which enable AVX2 in the source files that are only used after a runtime check
+# (x86 desktop targets only; MSVC supports /arch:AVX2 since Visual Studio 2013)
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86|x86)$" AND NOT (SFML_OS_IOS OR SFML_OS_ANDROID))
+    if(SFML_COMPILER_GCC OR SFML_COMPILER_CLANG)
+        set(SFML_AVX2_FLAGS "-mavx2")
+    elseif(SFML_COMPILER_MSVC AND NOT MSVC_VERSION LESS 1800)
+        set(SFML_AVX2_FLAGS "/arch:AVX2")
+    endif()
+endif()
+
 # define the install directory for miscellaneous files
 if(SFML_OS_WINDOWS OR SFML_OS_IOS)
     set(INSTALL_MISC_DIR .)
@@ -140,6 +140,36 @@ macro(sfml_add_library target)
             FRAMEWORK DESTINATION ${CMAKE_INSTALL_FRAMEWORK_PREFIX} COMPONENT bin)
 endmacro()
 
+# add a new target which is a SFML benchmark
+# benchmarks are not installed, and can include the internal headers of SFML
+# ex: sfml_add_benchmark(bench-image-kernels
+#                        SOURCES ImageKernels.cpp ...
+#                        DEPENDS sfml-system)
+macro(sfml_add_benchmark target)
+
+    # parse the arguments
+    cmake_parse_arguments(THIS "" "" "SOURCES;DEPENDS" ${ARGN})
+
+    # set a source group for the source files
+    source_group("" FILES ${THIS_SOURCES})
+
+    # create the target
+    add_executable(${target} ${THIS_SOURCES})
+    set_property(TARGET ${target} APPEND PROPERTY INCLUDE_DIRECTORIES ${PROJECT_SOURCE_DIR}/src)
+
+    # set the debug suffix
+    set_target_properties(${target} PROPERTIES DEBUG_POSTFIX -d)
+
+    # set the target's folder (for IDEs that support it, e.g. Visual Studio)
+    set_target_properties(${target} PROPERTIES FOLDER "Benchmarks")
+
+    # link the target to its SFML dependencies
+    if(THIS_DEPENDS)
+        target_link_libraries(${target} ${THIS_DEPENDS})
+    endif()
+
+endmacro()
+
 # add a new target which is a SFML example
 # ex: sfml_add_example(ftp
 #                      SOURCES ftp.cpp ...
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace
+{
+    unsigned int failures = 0;
+
+    ////////////////////////////////////////////////////////////
+    // Report an OpenGL error raised since the last check
+    ////////////////////////////////////////////////////////////
+    void checkErrors(sf::RenderWindow& window, const std::string& step)
+    {
+        window.setActive(true);
+
+        GLenum error = glGetError();
+        if (error == GL_NO_ERROR)
+            return;
+
+        while (glGetError() != GL_NO_ERROR)
+            ;
+
+        std::cout << "FAILED: " << step << " raised OpenGL error 0x" << std::hex << error << std::dec << std::endl;
+        failures++;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Check the color of a pixel of the back buffer (y goes down, like in SFML)
+    ////////////////////////////////////////////////////////////
+    void checkPixel(sf::RenderWindow& window, unsigned int x, unsigned int y, const sf::Color& expected, const std::string& step)
+    {
+        checkErrors(window, step);
+
+        sf::Uint8 pixel[4] = {0, 0, 0, 0};
+        glReadPixels(x, window.getSize().y - 1 - y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        sf::Color color(pixel[0], pixel[1], pixel[2], pixel[3]);
+
+        if ((std::abs(color.r - expected.r) > 2) || (std::abs(color.g - expected.g) > 2) || (std::abs(color.b - expected.b) > 2))
+        {
+            std::cout << "FAILED: " << step << ": pixel (" << x << ", " << y << ") is ("
+                      << static_cast<int>(color.r) << ", " << static_cast<int>(color.g) << ", " << static_cast<int>(color.b)
+                      << "), expected (" << static_cast<int>(expected.r) << ", " << static_cast<int>(expected.g) << ", "
+                      << static_cast<int>(expected.b) << ")" << std::endl;
+            failures++;
+        }
+        else
+        {
+            std::cout << "ok: " << step << std::endl;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Renders a few primitives to a window created with a core
+/// profile context and checks the result, without any user
+/// interaction. It can be run headless, for example with Mesa's
+/// software rasterizer inside a virtual X server:
+/// \code
+/// LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./core_profile
+/// \endcode
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Request a core profile context
+    sf::ContextSettings contextSettings(0, 0, 0, 3, 3, sf::ContextSettings::Core);
+    sf::RenderWindow window(sf::VideoMode(64, 64), "SFML core profile", sf::Style::Titlebar, contextSettings);
+
+    const sf::ContextSettings& settings = window.getSettings();
+    std::cout << "OpenGL " << settings.majorVersion << "." << settings.minorVersion
+              << ((settings.attributeFlags & sf::ContextSettings::Core) ? " core profile" : " compatibility profile") << std::endl;
+
+    if (!(settings.attributeFlags & sf::ContextSettings::Core))
+    {
+        std::cout << "FAILED: no core profile context could be created" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Clear must work before anything is drawn, it is the first call that sets the OpenGL states
+    window.clear(sf::Color::Red);
+    checkPixel(window, 8, 8, sf::Color::Red, "clear before any draw");
+
+    // Untextured geometry
+    sf::RectangleShape rectangle(sf::Vector2f(32, 32));
+    rectangle.setFillColor(sf::Color::Green);
+    window.draw(rectangle);
+    checkPixel(window, 16, 16, sf::Color::Green, "untextured shape");
+
+    // Textured geometry
+    sf::Image image;
+    image.create(8, 8, sf::Color::White);
+    sf::Texture texture;
+    texture.loadFromImage(image);
+    sf::Sprite sprite(texture);
+    sprite.setColor(sf::Color::Blue);
+    sprite.setPosition(32, 32);
+    sprite.setScale(4, 4);
+    window.draw(sprite);
+    checkPixel(window, 48, 48, sf::Color::Blue, "textured sprite");
+
+    // Batched geometry
+    window.setBatchingEnabled(true);
+    sprite.setColor(sf::Color::Yellow);
+    sprite.setPosition(0, 32);
+    window.draw(sprite);
+    sprite.setPosition(32, 0);
+    window.draw(sprite);
+    window.flush();
+    checkPixel(window, 16, 48, sf::Color::Yellow, "batched sprites (1/2)");
+    checkPixel(window, 48, 16, sf::Color::Yellow, "batched sprites (2/2)");
+
+    // A second clear, once the states are set
+    window.clear(sf::Color::White);
+    checkPixel(window, 32, 32, sf::Color::White, "clear after drawing");
+
+    window.display();
+    checkErrors(window, "display");
+
+    if (failures > 0)
+    {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
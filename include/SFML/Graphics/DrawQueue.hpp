@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWQUEUE_HPP
+#define SFML_DRAWQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class DrawQueueRecorder;
+    class GlyphAtlas;
+}
+
+class Drawable;
+class Font;
+class RenderTarget;
+class Texture;
+class VertexBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Deferred list of draws, sorted by layer and render
+///        states before being rendered
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State changes of the last submitted queue
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to 0.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        std::size_t draws;                  ///< Number of draws that were submitted
+        std::size_t stateChanges;           ///< Number of shader, texture and blend mode changes, in sorted order
+        std::size_t stateChangesEliminated; ///< Number of state changes that sorting saved compared to recording order
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DrawQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a drawable object
+    ///
+    /// The primitives that the drawable produces are copied into
+    /// the queue, so the drawable doesn't have to outlive it.
+    /// However the textures and shaders that it uses must exist
+    /// until the queue is submitted. Texts are safe to record:
+    /// their font doesn't release or rewrite the glyphs that
+    /// a queue refers to before it is submitted or cleared.
+    ///
+    /// \param drawable Object to record
+    /// \param layer    Layer of the object, lower layers are rendered first
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, int layer = 0, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied into the queue.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param layer       Layer of the primitives, lower layers are rendered first
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+             int layer = 0, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded draws
+    ///
+    /// This function keeps the allocated memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded draws
+    ///
+    /// \return Number of draws waiting to be submitted
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the recorded draws and render them to a target
+    ///
+    /// Draws are sorted by layer, then by shader, texture and
+    /// blend mode. Draws of the same layer that use the same
+    /// render states keep their recording order. The queue is
+    /// cleared afterwards, ready to record the next frame.
+    ///
+    /// \param target Render target to draw to
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last submission
+    ///
+    /// \return Statistics of the last call to submit
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+private:
+
+    friend class RenderTarget;
+    friend class Font;
+    friend class priv::GlyphAtlas;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a texture is used by draws that are
+    ///        waiting to be submitted in any queue
+    ///
+    /// Fonts use this function to keep the glyphs that recorded
+    /// draws refer to until the queues are submitted.
+    ///
+    /// \param texture Texture to look for
+    ///
+    /// \return True if a recorded draw uses the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isRecorded(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices,
+    ///        in the current layer
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by a vertex buffer,
+    ///        in the current layer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        int                 layer;        ///< Layer of the draw
+        RenderStates        states;       ///< Render states of the draw
+        PrimitiveType       type;         ///< Type of primitives (unused for vertex buffers)
+        const VertexBuffer* vertexBuffer; ///< Vertex buffer to draw, or NULL to draw copied vertices
+        std::size_t         firstVertex;  ///< Index of the first vertex, in the queue's vertices or in the vertex buffer
+        std::size_t         vertexCount;  ///< Number of vertices to draw
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sorting predicate of the recorded draws
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CommandLess
+    {
+        bool operator ()(const Command& left, const Command& right) const;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count the state changes needed to render a list of draws
+    ///
+    /// \param commands Draws, in rendering order
+    ///
+    /// \return Number of shader, texture and blend mode changes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t countStateChanges(const std::vector<Command>& commands);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command>     m_commands;   ///< Recorded draws
+    std::vector<Vertex>      m_vertices;   ///< Copied vertices of the recorded draws
+    int                      m_layer;      ///< Layer of the drawable being recorded
+    priv::DrawQueueRecorder* m_recorder;   ///< Render target capturing the primitives of drawables (created on first use)
+    Statistics               m_statistics; ///< Statistics of the last submission
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawQueue
+/// \ingroup graphics
+///
+/// sf::RenderTarget avoids redundant state changes only between
+/// consecutive draws: if a frame alternates between textures
+/// (UI, world, UI, ...), every draw changes the texture and
+/// automatic batching can't merge anything.
+///
+/// sf::DrawQueue records the draws of a frame instead of rendering
+/// them immediately. Each draw is given a layer, and the queue
+/// is rendered with submit(), which sorts the draws by layer and,
+/// inside a layer, groups the draws that use the same shader,
+/// texture and blend mode. Draws are therefore free to be
+/// reordered inside a layer: use different layers for things
+/// that must be rendered on top of each other.
+///
+/// Combined with RenderTarget::setBatchingEnabled, grouped draws
+/// are merged into a minimal number of draw calls.
+/// getStatistics() tells how many state changes sorting saved.
+///
+/// Usage example:
+/// \code
+/// sf::DrawQueue queue;
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     for (std::size_t i = 0; i < tiles.size(); ++i)
+///         queue.add(tiles[i], 0);
+///     for (std::size_t i = 0; i < entities.size(); ++i)
+///         queue.add(entities[i], 1);
+///     queue.add(hud, 2);
+///
+///     window.clear();
+///     queue.submit(window);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -42,6 +42,16 @@
 namespace sf
 {
 class InputStream;
+class Shader;
+
+class GlyphTicket;
+
+namespace priv
+{
+    class GlyphAtlas;
+    class GlyphRasterizer;
+    template <typename Key, typename Value> class FlatHashMap;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -60,6 +70,21 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the glyph cache of a font
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CacheStats
+    {
+        std::size_t glyphCount;       ///< Number of glyphs currently cached
+        std::size_t textureCount;     ///< Number of glyph textures (one per character size, or one if shared)
+        std::size_t textureBytes;     ///< Memory used by the glyph textures, in bytes
+        Uint64      hits;             ///< Number of glyph requests served from the cache
+        Uint64      misses;           ///< Number of glyph requests which had to rasterize the glyph
+        Uint64      evictedGlyphs;    ///< Number of glyphs evicted to make room for new ones
+        Uint64      releasedTextures; ///< Number of glyph textures released to respect the memory budget
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -254,48 +279,324 @@ public:
     const Texture& getTexture(unsigned int characterSize) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Overload of assignment operator
+    /// \brief Enable or disable the shared glyph atlas
     ///
-    /// \param right Instance to assign
+    /// By default, the glyphs of each character size are stored
+    /// in their own texture. When the shared atlas is enabled,
+    /// the glyphs of all the sizes, styles and outlines go into
+    /// a single texture, so that texts of different sizes can be
+    /// drawn without switching textures (and batched together).
     ///
-    /// \return Reference to self
+    /// Changing this setting discards the glyphs already loaded.
+    /// The shared atlas is disabled by default.
+    ///
+    /// \param enabled True to store all the glyphs in one texture
+    ///
+    /// \see isSharedAtlasEnabled, setAtlasMemoryLimit
     ///
     ////////////////////////////////////////////////////////////
-    Font& operator =(const Font& right);
+    void setSharedAtlasEnabled(bool enabled);
 
-private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the shared glyph atlas is enabled or not
+    ///
+    /// \return True if all the glyphs are stored in one texture
+    ///
+    /// \see setSharedAtlasEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSharedAtlasEnabled() const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Set the maximum amount of memory used by a glyph texture
+    ///
+    /// Glyph textures grow as new glyphs are loaded. Once a
+    /// texture reaches this limit (or the maximum texture size),
+    /// the least recently used glyphs are evicted to make room
+    /// for the new ones. With the shared atlas, this bounds the
+    /// memory used by all the glyphs of the font; otherwise it
+    /// applies to the texture of each character size.
+    ///
+    /// Texts which used evicted glyphs reload them automatically
+    /// the next time they are drawn. The limit should therefore
+    /// be large enough for the glyphs displayed in a single
+    /// frame, otherwise they keep evicting each other.
+    ///
+    /// \param bytes Memory limit, in bytes (0 means no limit, the default)
+    ///
+    /// \see getAtlasMemoryLimit
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
-    {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+    void setAtlasMemoryLimit(std::size_t bytes);
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
-    };
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by a glyph texture
+    ///
+    /// \return Memory limit, in bytes (0 means no limit)
+    ///
+    /// \see setAtlasMemoryLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAtlasMemoryLimit() const;
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Set the maximum amount of memory used by all the glyph textures
+    ///
+    /// Whereas setAtlasMemoryLimit bounds each texture, the
+    /// budget bounds the sum of the textures of all the character
+    /// sizes. When it is exceeded, the textures of the least
+    /// recently used character sizes are released; no texture
+    /// grows beyond the budget on its own, its least recently
+    /// used glyphs are evicted instead.
+    ///
+    /// Texts which used a released texture reload their glyphs
+    /// the next time they are drawn. References returned by
+    /// getTexture and getGlyph for other character sizes may
+    /// be invalidated whenever a glyph is loaded.
+    ///
+    /// Lowering the budget below the current usage releases
+    /// textures immediately.
+    ///
+    /// Releasing or evicting is safe while draws are pending:
+    /// the render targets whose batch uses a texture are flushed
+    /// before it is modified or released, and the textures that
+    /// a sf::DrawQueue has recorded draws with are neither
+    /// released nor evicted from until the queue is submitted
+    /// (the budget may be exceeded in the meantime).
+    ///
+    /// \param bytes Memory budget, in bytes (0 means no budget, the default)
+    ///
+    /// \see getMemoryBudget, getCacheStats
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    void setMemoryBudget(std::size_t bytes);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a page of glyphs
+    /// \brief Get the maximum amount of memory used by all the glyph textures
+    ///
+    /// \return Memory budget, in bytes (0 means no budget)
+    ///
+    /// \see setMemoryBudget
     ///
     ////////////////////////////////////////////////////////////
-    struct Page
-    {
-        Page();
+    std::size_t getMemoryBudget() const;
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
-    };
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the glyph cache
+    ///
+    /// The counters of requests, evictions and releases are
+    /// accumulated since the font was loaded.
+    ///
+    /// \return Statistics of the glyph cache
+    ///
+    /// \see setMemoryBudget, setAtlasMemoryLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    CacheStats getCacheStats() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable signed distance field glyphs
+    ///
+    /// In distance field mode, each glyph is rasterized only
+    /// once, at a fixed reference size, into a texture which
+    /// stores the distance to the outline of the glyph rather
+    /// than its coverage. The glyphs of all the other character
+    /// sizes reuse these pixels, and sf::Text renders them
+    /// sharply at any scale with a dedicated shader (see
+    /// getDistanceFieldShader). Changing the character size or
+    /// scaling a text then costs no rasterization and no texture
+    /// memory, and all the sizes share a single texture.
+    ///
+    /// The bounds of distance field glyphs include the margin
+    /// in which the distance is stored. This mode requires
+    /// shaders, and is meant for scalable fonts; bitmap fonts
+    /// have no glyph at the reference size.
+    ///
+    /// Render targets using a core profile context, which can't
+    /// run sf::Shader, render the distance field glyphs with an
+    /// equivalent mode of their built-in shader instead.
+    ///
+    /// Changing this setting discards the glyphs already loaded.
+    ///
+    /// \param enabled True to use distance field glyphs
+    ///
+    /// \return False if distance field glyphs are requested but shaders are not available
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the glyphs are signed distance fields
+    ///
+    /// \return True if distance field glyphs are enabled
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader which renders distance field glyphs
+    ///
+    /// sf::Text uses this shader automatically, unless another
+    /// one is given in its render states. It is useful to draw
+    /// the glyphs of the font with custom geometry.
+    ///
+    /// \return Pointer to the shader, or NULL if shaders are not available
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getDistanceFieldShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs ahead of time
+    ///
+    /// Glyphs are normally rasterized the first time they are
+    /// requested, which can make the first frame that displays
+    /// a new string slower. This function loads all the glyphs
+    /// of \a characters at once, for example during a loading
+    /// screen, and enlarges the texture only once for all of
+    /// them. Call it once for each combination of size and
+    /// style that will be displayed.
+    ///
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold versions or the regular ones?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a set of glyphs on worker threads
+    ///
+    /// This is an asynchronous version of preload: the glyphs
+    /// of \a characters that are not loaded yet are rasterized
+    /// by \a threadCount worker threads, each one using its
+    /// own copy of the font face, and this function returns
+    /// immediately. The glyphs are added to the texture when
+    /// GlyphTicket::wait is called, with a single update.
+    ///
+    /// Fonts loaded from a stream are read entirely, so that
+    /// the workers don't use the stream.
+    ///
+    /// \param ticket           Ticket tracking the request (it must not have a pending request)
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold versions or the regular ones?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    /// \param threadCount      Number of worker threads
+    ///
+    /// \return True if the request was started, false on error
+    ///
+    /// \see preload, GlyphTicket
+    ///
+    ////////////////////////////////////////////////////////////
+    bool requestGlyphs(GlyphTicket& ticket, const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0, unsigned int threadCount = 4) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the loaded glyphs to a file
+    ///
+    /// The glyph cache contains the metrics and the pixels of
+    /// all the glyphs loaded so far. Loading it back with
+    /// loadGlyphCacheFromFile (or its variants) restores them
+    /// without rasterizing anything, which is useful to ship
+    /// a cache built offline with preload.
+    ///
+    /// The font must be loaded, and the format of the file is
+    /// specific to SFML.
+    ///
+    /// \param filename Path of the file to save
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadGlyphCacheFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveGlyphCacheToFile(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a glyph cache from a file
+    ///
+    /// The glyphs loaded previously are replaced by the ones
+    /// of the cache, and the shared atlas and distance field
+    /// settings are set to the ones the cache was saved with.
+    /// The font must be loaded first, and it must be the one
+    /// the cache was created from. Glyphs missing from the
+    /// cache are rasterized as usual when they are requested.
+    ///
+    /// \param filename Path of the glyph cache to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCacheToFile, loadGlyphCacheFromMemory, loadGlyphCacheFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCacheFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a glyph cache from a file in memory
+    ///
+    /// See loadGlyphCacheFromFile. The data is not needed
+    /// anymore once this function returns.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCacheToFile, loadGlyphCacheFromFile, loadGlyphCacheFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCacheFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a glyph cache from a custom stream
+    ///
+    /// See loadGlyphCacheFromFile.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCacheToFile, loadGlyphCacheFromFile, loadGlyphCacheFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCacheFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Font& operator =(const Font& right);
+
+private:
+
+    friend class Text;
+    friend class TextBatch;
+    friend class GlyphTicket;
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a shader renders distance field glyphs
+    ///
+    /// Render targets that can't use sf::Shader (core profile
+    /// contexts) use this function to render distance field
+    /// glyphs with their built-in program instead.
+    ///
+    /// \param shader Shader to check
+    ///
+    /// \return True if the shader is the distance field shader of a font
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isDistanceFieldShader(const Shader* shader);
 
     ////////////////////////////////////////////////////////////
     /// \brief Free all the internal resources
@@ -317,16 +618,80 @@ private:
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Find a suitable rectangle within the texture for a glyph
+    /// \brief Retrieve a glyph in distance field mode
+    ///
+    /// \param atlas            Atlas of the glyphs
+    /// \param codePoint        Unicode code point of the character to get
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    ///
+    /// \return The glyph rasterized at the reference size, scaled to \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getDistanceFieldGlyph(priv::GlyphAtlas& atlas, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the atlas storing the glyphs of a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Atlas of the glyphs (the shared one if enabled or in distance field mode)
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::GlyphAtlas& getAtlas(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the glyph atlases
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearAtlases();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the memory limit of each glyph atlas
+    ///
+    /// \return Smallest of the atlas limit and the memory budget (0 for no limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEffectiveAtlasLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the least recently used atlases until the memory budget is respected
+    ///
+    /// \param current Atlas which must be kept (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyMemoryBudget(const priv::GlyphAtlas* current) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the generation of the glyphs of a character size
     ///
-    /// \param page   Page of glyphs to search in
-    /// \param width  Width of the rectangle
-    /// \param height Height of the rectangle
+    /// The generation changes whenever glyphs of the atlas are
+    /// evicted or replaced, which invalidates the texture
+    /// rectangles previously returned by getGlyph.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Generation of the atlas storing the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getGlyphGeneration(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the glyphs rasterized by worker threads to the atlas
+    ///
+    /// \param rasterizer Workers which rasterized the glyphs (they must be done)
+    ///
+    ////////////////////////////////////////////////////////////
+    void addRasterizedGlyphs(priv::GlyphRasterizer& rasterizer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a ticket whose request is over
     ///
-    /// \return Found rectangle within the texture
+    /// \param ticket Ticket to remove from the pending ones
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    void removeTicket(GlyphTicket* ticket) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -341,7 +706,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, priv::GlyphAtlas*> AtlasTable; ///< Table mapping a character size to its atlas (texture)
+    typedef priv::FlatHashMap<Uint64, float> KerningTable; ///< Table mapping a character size and pair of code points to their kerning
+    typedef std::vector<GlyphTicket*> TicketList; ///< List of tickets with a pending request
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -352,8 +719,21 @@ private:
     void*                      m_stroker;     ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
     int*                       m_refCount;    ///< Reference counter used by implicit sharing
     Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
+    mutable AtlasTable         m_atlases;     ///< Table containing the glyph atlases by character size (a single one with key 0 when shared)
     mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    bool                       m_sharedAtlas; ///< Are the glyphs of all the sizes stored in the same atlas?
+    std::size_t                m_atlasLimit;  ///< Maximum memory used by a glyph atlas, in bytes (0 for no limit)
+    std::size_t                m_budget;      ///< Maximum memory used by all the glyph atlases, in bytes (0 for no limit)
+    mutable Uint64             m_atlasClock;  ///< Usage clock of the atlases, incremented each time one is requested
+    mutable Uint64             m_cacheHits;   ///< Number of glyph requests served from the cache
+    mutable Uint64             m_cacheMisses; ///< Number of glyph requests which rasterized the glyph
+    mutable Uint64             m_releases;    ///< Number of atlases released to respect the memory budget
+    mutable Uint64             m_evictions;   ///< Number of glyphs evicted from the atlases already released
+    bool                       m_sdfEnabled;  ///< Are the glyphs rasterized as signed distance fields?
+    mutable Shader*            m_sdfShader;   ///< Shader rendering distance field glyphs (created on first use)
+    mutable KerningTable*      m_kerning;     ///< Kerning of the character pairs already requested (created on first use)
+    std::string                m_fileName;    ///< Path of the font file, used by the rasterization workers (empty if not loaded from a file)
+    mutable TicketList         m_tickets;     ///< Tickets of the glyph requests being rasterized by workers
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLYPHTICKET_HPP
+#define SFML_GLYPHTICKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class Font;
+
+namespace priv
+{
+    class GlyphRasterizer;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Pending rasterization of glyphs on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GlyphTicket : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a ticket with no pending request.
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending request is cancelled: the workers are
+    /// stopped and the glyphs they rasterized are discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a request is pending
+    ///
+    /// A request remains pending until wait() is called, or
+    /// until the font is destroyed or reloaded.
+    ///
+    /// \return True if a request is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the glyphs are rasterized
+    ///
+    /// This function doesn't block, it is meant to be polled
+    /// once per frame. When it returns true, wait() doesn't
+    /// block either.
+    ///
+    /// \return True if the glyphs can be added without waiting
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of the glyphs already rasterized
+    ///
+    /// \return Progress of the request, between 0 and 1
+    ///
+    ////////////////////////////////////////////////////////////
+    float getProgress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the rasterized glyphs to the font
+    ///
+    /// If the workers are not done yet, this function waits
+    /// for them. The glyphs are then written to the texture of
+    /// the font, which requires an active OpenGL context: call
+    /// it from the thread that draws the texts.
+    ///
+    /// \return True if glyphs were added, false if no request was pending
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait();
+
+private:
+
+    friend class Font;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the workers and discard the pending request
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*            m_font;       ///< Font which requested the glyphs
+    priv::GlyphRasterizer* m_rasterizer; ///< Workers rasterizing the glyphs
+};
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHTICKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GlyphTicket
+/// \ingroup graphics
+///
+/// Rasterizing glyphs is slow: a text using thousands of
+/// different characters, such as Chinese or Japanese text,
+/// can take a noticeable time to display the first time.
+///
+/// Font::requestGlyphs rasterizes a set of glyphs in advance,
+/// on several worker threads, and returns immediately. The
+/// request is tracked by a sf::GlyphTicket: isReady() and
+/// getProgress() tell how far the workers are, and wait()
+/// adds the rasterized glyphs to the font's texture, all at
+/// once. Until then, the font works as usual: glyphs that
+/// are needed right away are rasterized on demand.
+///
+/// If the font is destroyed or reloaded while the request
+/// is pending, the request is cancelled.
+///
+/// Usage example (loading screen):
+/// \code
+/// sf::GlyphTicket ticket;
+/// font.requestGlyphs(ticket, dialogueCharacters, 24);
+///
+/// while (!ticket.isReady())
+/// {
+///     progressBar.setProgress(ticket.getProgress());
+///     ...
+///     window.draw(progressBar);
+///     window.display();
+/// }
+///
+/// ticket.wait();
+/// \endcode
+///
+/// \see sf::Font
+///
+////////////////////////////////////////////////////////////
@@ -38,6 +38,8 @@
 namespace sf
 {
 class InputStream;
+class OutputStream;
+class SaveTicket;
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading, manipulating and saving images
@@ -47,6 +49,17 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to resample an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResamplingFilter
+    {
+        Box,      ///< Average of the covered pixels (nearest pixel when enlarging), fastest
+        Bilinear, ///< Linear interpolation (triangle filter when shrinking)
+        Lanczos   ///< Windowed sinc with 3 lobes, sharpest but slowest
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -86,6 +99,22 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for the pixels of an image of the given size
+    ///
+    /// The content and size of the image are not changed. The
+    /// reserved memory is used by the next load functions, which
+    /// decode images up to this size without allocating memory.
+    /// This is useful for images reused to load many files.
+    ///
+    /// \param width  Width of the largest image to load
+    /// \param height Height of the largest image to load
+    ///
+    /// \see loadFromFile, loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(unsigned int width, unsigned int height);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
@@ -93,6 +122,8 @@ public:
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
+    /// The pixels are decoded in the memory already owned by
+    /// the image when it is large enough (see reserve).
     ///
     /// \param filename Path of the image file to load
     ///
@@ -110,6 +141,8 @@ public:
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
+    /// The pixels are decoded in the memory already owned by
+    /// the image when it is large enough (see reserve).
     ///
     /// \param data Pointer to the file data in memory
     /// \param size Size of the data to load, in bytes
@@ -128,6 +161,8 @@ public:
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
+    /// The pixels are decoded in the memory already owned by
+    /// the image when it is large enough (see reserve).
     ///
     /// \param stream Source stream to read from
     ///
@@ -150,11 +185,68 @@ public:
     ///
     /// \return True if saving was successful
     ///
-    /// \see create, loadFromFile, loadFromMemory
+    /// \see create, loadFromFile, loadFromMemory, saveToFileAsync
     ///
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file in memory
+    ///
+    /// The format of the image is given by its usual file
+    /// extension: the supported image formats are bmp, png,
+    /// tga and jpg. This function fails if the image is empty.
+    ///
+    /// \param output Array of bytes receiving the file
+    /// \param format Format of the file ("png", "jpg", ...)
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile, saveToStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a custom stream
+    ///
+    /// The format of the image is given by its usual file
+    /// extension: the supported image formats are bmp, png,
+    /// tga and jpg. The file is encoded and written to the
+    /// stream a few rows at a time, without converting the
+    /// whole image first. This function fails if the image
+    /// is empty.
+    ///
+    /// \param stream Destination stream
+    /// \param format Format of the file ("png", "jpg", ...)
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile, saveToMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToStream(OutputStream& stream, const std::string& format) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file on disk, on a background thread
+    ///
+    /// This function copies the pixels and returns immediately:
+    /// the image can be modified or destroyed right away. The
+    /// file is written by a thread of the ticket, and the result
+    /// of the save is returned by SaveTicket::wait. If the ticket
+    /// already has a save in progress, this function waits for
+    /// it first.
+    ///
+    /// \param ticket   Ticket tracking the save
+    /// \param filename Path of the file to save
+    ///
+    /// \return True if the save was started, false if the image is empty
+    ///
+    /// \see saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFileAsync(SaveTicket& ticket, const std::string& filename) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -258,8 +350,101 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample the image to a new size
+    ///
+    /// The image is filtered horizontally then vertically, with
+    /// premultiplied alpha so that the color of transparent
+    /// pixels doesn't bleed into their neighbours. The filter is
+    /// widened when shrinking, so that all the source pixels
+    /// contribute to the result.
+    ///
+    /// Large images can be processed by several threads, each
+    /// one handling a strip of rows. Besides the new pixels, a
+    /// thread needs 16 bytes per new pixel of a row, for each
+    /// source row under the filter (a few rows when enlarging,
+    /// more when shrinking by a large factor).
+    ///
+    /// \param width       New width of the image, in pixels
+    /// \param height      New height of the image, in pixels
+    /// \param filter      Filter used to compute the new pixels
+    /// \param threadCount Maximum number of threads to use
+    ///
+    /// \see blur
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResamplingFilter filter = Bilinear, unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blur the image with a gaussian filter
+    ///
+    /// The filter is applied horizontally then vertically, with
+    /// premultiplied alpha. Pixels outside the image are
+    /// considered equal to the closest edge pixel.
+    ///
+    /// The image is blurred in place: a thread needs 16 bytes
+    /// per pixel of a row, for each row within 3 * sigma of the
+    /// current one. With several threads, the rows read by two
+    /// strips are also copied.
+    ///
+    /// \param sigma       Standard deviation of the filter, in pixels
+    /// \param threadCount Maximum number of threads to use
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    void blur(float sigma, unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of the pixels by their alpha
+    ///
+    /// Images with premultiplied alpha must be drawn with the
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)
+    /// blend mode.
+    ///
+    /// \see unpremultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color components of the pixels by their alpha
+    ///
+    /// This function reverts premultiplyAlpha, up to the
+    /// precision lost by the multiplication. Fully transparent
+    /// pixels are left unchanged.
+    ///
+    /// \see premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the color components from sRGB to linear values
+    ///
+    /// The alpha component is left unchanged. As the result is
+    /// stored in 8 bits, dark colors lose precision.
+    ///
+    /// \see convertLinearToSrgb
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertSrgbToLinear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the color components from linear values to sRGB
+    ///
+    /// The alpha component is left unchanged.
+    ///
+    /// \see convertSrgbToLinear
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertLinearToSrgb();
+
 private:
 
+    friend class ImageBatchLoader;
+    friend class ReadbackTicket;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -294,6 +479,13 @@ private:
 /// functions (such as loadFromMemory) must use this
 /// representation as well.
 ///
+/// Besides direct pixel access, sf::Image provides common
+/// processing functions: resampling (resize), gaussian blur,
+/// alpha premultiplication and conversion between the sRGB
+/// and linear color spaces. They use vector instructions when
+/// available, and resize and blur can split large images in
+/// strips processed by several threads.
+///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
 /// pass or return them to avoid useless copies.
@@ -312,6 +504,11 @@ private:
 /// // Copy image1 on image2 at position (10, 10)
 /// image.copy(background, 10, 10);
 ///
+/// // Make a smaller, slightly blurred copy of the background
+/// sf::Image thumbnail = background;
+/// thumbnail.resize(64, 48, sf::Image::Lanczos);
+/// thumbnail.blur(0.8f);
+///
 /// // Make the top-left pixel transparent
 /// sf::Color color = image.getPixel(0, 0);
 /// color.a = 0;
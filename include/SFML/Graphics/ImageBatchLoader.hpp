@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEBATCHLOADER_HPP
+#define SFML_IMAGEBATCHLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class InputStream;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Loader of many images at once on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageBatchLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Status of an image of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Pending, ///< The image is not loaded yet
+        Loaded,  ///< The image (and its texture, if requested) was loaded
+        Failed   ///< The image couldn't be loaded, see getError
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatchLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The loading is cancelled.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageBatchLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file on disk to the batch
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Index of the image in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file in memory to the batch
+    ///
+    /// The memory is read by the worker threads: it must
+    /// remain valid until the batch is loaded.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Index of the image in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image read from a custom stream to the batch
+    ///
+    /// The stream is read by one of the worker threads: it must
+    /// remain valid, and not be used by other threads, until
+    /// the batch is loaded.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Index of the image in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the pending images of the batch
+    ///
+    /// This function returns immediately: the images are
+    /// decoded by \a threadCount worker threads. If
+    /// \a createTextures is true, each image is also uploaded
+    /// to a texture by one of the workers, which activates an
+    /// OpenGL context of its own; the textures can then be used
+    /// in any context.
+    ///
+    /// Images added while the batch is loading are loaded by
+    /// the running workers, unless they are already done.
+    /// If the batch is already loading, this function does nothing.
+    ///
+    /// \param threadCount    Number of worker threads
+    /// \param createTextures Upload the loaded images to textures?
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(unsigned int threadCount = 4, bool createTextures = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the workers are done
+    ///
+    /// This function doesn't block, it is meant to be polled
+    /// once per frame. When it returns true, wait() doesn't
+    /// block either.
+    ///
+    /// \return True if no image is being loaded
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of the images already loaded
+    ///
+    /// Images that failed to load count as done.
+    ///
+    /// \return Progress of the batch, between 0 and 1
+    ///
+    ////////////////////////////////////////////////////////////
+    float getProgress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the workers are done
+    ///
+    /// The errors of the images that failed to load are
+    /// written to the error output.
+    ///
+    /// \return True if all the images of the batch were loaded
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the workers as soon as possible
+    ///
+    /// The images being loaded are finished, the others are
+    /// left pending and can be loaded by a new call to launch().
+    /// This function waits for the workers.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images from the batch
+    ///
+    /// The loading is cancelled first.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the batch
+    ///
+    /// \return Number of images
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the status of an image of the batch
+    ///
+    /// This function can be called while the batch is loading.
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return Status of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the reason why an image failed to load
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return Error message, or an empty string if the image didn't fail
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getError(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a loaded image of the batch
+    ///
+    /// The image must only be used once its status is Loaded:
+    /// until then, it belongs to the worker threads.
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return Image (empty if it's not loaded)
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& getImage(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a loaded image of the batch
+    ///
+    /// The texture only exists if the batch was launched with
+    /// \a createTextures, and must only be used once the status
+    /// of the image is Loaded.
+    ///
+    /// \param index Index of the image
+    ///
+    /// \return Texture (empty if it's not created)
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& getTexture(std::size_t index);
+
+private:
+
+    struct Job;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a job to the batch
+    ///
+    /// \param job Job to add, owned by the batch
+    ///
+    /// \return Index of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(Job* job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Job*>    m_jobs;           ///< Images of the batch
+    std::vector<Job*>    m_uploads;        ///< Images decoded and waiting for their texture
+    std::vector<Thread*> m_threads;        ///< Worker threads
+    mutable Mutex        m_mutex;          ///< Mutex protecting the state of the jobs and of the workers
+    std::size_t          m_next;           ///< Index of the next job to look at
+    std::size_t          m_finished;       ///< Number of jobs loaded or failed
+    unsigned int         m_decoding;       ///< Number of images being decoded
+    unsigned int         m_running;        ///< Number of workers still running
+    bool                 m_createTextures; ///< Upload the images to textures?
+    bool                 m_uploaderTaken;  ///< Has a worker taken the role of uploader?
+    bool                 m_cancelled;      ///< Must the workers stop?
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEBATCHLOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageBatchLoader
+/// \ingroup graphics
+///
+/// Loading many images one after the other with
+/// sf::Image::loadFromFile keeps a single core busy, most of
+/// the time decoding pixels. sf::ImageBatchLoader decodes a
+/// set of image files on several worker threads, and returns
+/// immediately.
+///
+/// Optionally, the loaded images are uploaded to textures as
+/// they are decoded. The uploads are made by a single worker,
+/// with an OpenGL context of its own that is shared with the
+/// other contexts; the thread that draws is never blocked
+/// by them.
+///
+/// getProgress() and isReady() tell how far the workers are,
+/// getStatus() and getError() report the result of each file,
+/// and wait() blocks until all of them are done. The images
+/// and textures belong to the batch: it must be kept alive
+/// (and not cleared) as long as they are used.
+///
+/// Usage example (loading screen):
+/// \code
+/// sf::ImageBatchLoader loader;
+/// for (std::size_t i = 0; i < files.size(); ++i)
+///     loader.add(files[i]);
+///
+/// loader.launch(4, true);
+///
+/// while (!loader.isReady())
+/// {
+///     progressBar.setProgress(loader.getProgress());
+///     ...
+///     window.draw(progressBar);
+///     window.display();
+/// }
+///
+/// loader.wait();
+///
+/// for (std::size_t i = 0; i < loader.getCount(); ++i)
+/// {
+///     if (loader.getStatus(i) == sf::ImageBatchLoader::Loaded)
+///         sprites[i].setTexture(loader.getTexture(i));
+///     else
+///         std::cout << loader.getError(i) << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_READBACKTICKET_HPP
+#define SFML_READBACKTICKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Pending transfers of pixels from the GPU to the CPU
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ReadbackTicket : NonCopyable, private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a ticket with no pending readback.
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadbackTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending readbacks are discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ReadbackTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of readbacks that were requested
+    ///        and not retrieved yet
+    ///
+    /// A ticket holds up to two pending readbacks: one can be
+    /// requested while the previous one is still in progress.
+    ///
+    /// \return Number of pending readbacks (0, 1 or 2)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the oldest pending readback is done
+    ///
+    /// This function doesn't block, it is meant to be polled
+    /// once per frame. When it returns true, retrieve() doesn't
+    /// block either.
+    ///
+    /// \return True if a readback can be retrieved without waiting
+    ///
+    /// \see retrieve
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of the oldest pending readback to an image
+    ///
+    /// The pixels are written directly to the storage of \a image,
+    /// which is resized if needed; when its size is already the
+    /// right one, no memory is allocated. If the readback is not
+    /// done yet, this function waits for it.
+    ///
+    /// \param image Image receiving the pixels
+    ///
+    /// \return True if a readback was retrieved, false if none was pending
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool retrieve(Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous readbacks
+    ///
+    /// Asynchronous readbacks need pixel buffer objects and sync
+    /// objects. When they are not available, requesting a readback
+    /// fails.
+    ///
+    /// \return True if asynchronous readbacks are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class Texture;
+    friend class RenderWindow;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Readback stored in a pixel buffer object
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        unsigned int buffer;  ///< Pixel buffer object receiving the pixels
+        std::size_t  size;    ///< Size of the storage of the buffer, in bytes
+        void*        fence;   ///< Fence signaled when the pixels are in the buffer
+        Vector2u     pixels;  ///< Size of the image to extract from the buffer
+        unsigned int pitch;   ///< Number of bytes between two rows in the buffer
+        bool         flipped; ///< Are the rows stored from bottom to top?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the buffer of the next readback
+    ///
+    /// The buffer is bound to GL_PIXEL_PACK_BUFFER, so that
+    /// the caller can read pixels into it, at offset 0.
+    /// A context must be active.
+    ///
+    /// \param size Number of bytes that will be read
+    ///
+    /// \return True on success, false if two readbacks are already pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool beginRead(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the readback started with beginRead
+    ///
+    /// \param pixels  Size of the image to extract from the buffer
+    /// \param pitch   Number of bytes between two rows in the buffer
+    /// \param flipped Are the rows stored from bottom to top?
+    ///
+    ////////////////////////////////////////////////////////////
+    void endRead(const Vector2u& pixels, unsigned int pitch, bool flipped);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Slot        m_slots[2]; ///< Buffers alternately used by the readbacks
+    std::size_t m_first;    ///< Index of the slot of the oldest pending readback
+    std::size_t m_count;    ///< Number of pending readbacks
+};
+
+} // namespace sf
+
+
+#endif // SFML_READBACKTICKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ReadbackTicket
+/// \ingroup graphics
+///
+/// Reading pixels back from the GPU with Texture::copyToImage
+/// blocks until all the pending rendering is done, and then
+/// until the pixels are transferred: for large images this
+/// takes several milliseconds.
+///
+/// sf::ReadbackTicket makes the transfer asynchronous. A readback
+/// is requested with Texture::copyToImageAsync or
+/// RenderWindow::captureAsync, which copy the pixels to a pixel
+/// buffer object owned by the ticket and return immediately. On
+/// a later frame, isReady() tells whether the transfer is done,
+/// and retrieve() copies the pixels to an sf::Image.
+///
+/// A ticket holds two buffers, so a new readback can be requested
+/// every frame as long as the previous one is retrieved in time:
+/// requesting a third readback fails until one is retrieved.
+///
+/// Usage example (recording a replay):
+/// \code
+/// sf::ReadbackTicket ticket;
+/// sf::Image frame;
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.draw(scene);
+///
+///     // Capture this frame, and save the previous one if it's ready
+///     window.captureAsync(ticket);
+///     while (ticket.isReady() && ticket.retrieve(frame))
+///         recorder.addFrame(frame);
+///
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderWindow, sf::Image
+///
+////////////////////////////////////////////////////////////
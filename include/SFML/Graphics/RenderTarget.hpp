@@ -38,11 +38,21 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class DrawQueue;
+class VertexBuffer;
+
+namespace priv
+{
+    class CoreRenderer;
+    class GlyphAtlas;
+    class StreamBuffer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -52,6 +62,26 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering statistics of a render target
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Uint64 drawsSubmitted; ///< Number of primitive batches submitted through the draw functions
+        Uint64 drawCalls;      ///< Number of draw calls actually issued to OpenGL
+        Uint64 bytesStreamed;  ///< Number of bytes of vertex data uploaded to graphics memory
+        Uint64 streamStalls;   ///< Number of times an upload had to wait for the GPU to release buffer memory
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -247,6 +277,139 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// Vertex buffers are never batched nor transformed on the
+    /// CPU: their vertices are sourced directly from graphics
+    /// memory and transformed by the graphics card.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the vertex cache
+    ///
+    /// Primitives that have at most this number of vertices are
+    /// transformed on the CPU and copied into an internal cache,
+    /// which avoids changing the OpenGL transform for every draw.
+    /// Larger primitives are transformed by the graphics card.
+    /// Increasing the size lets larger dynamic meshes benefit from
+    /// the cache, at the cost of more CPU work per draw.
+    ///
+    /// The default size is 4 vertices, which covers sprites and
+    /// rectangle shapes.
+    ///
+    /// \param size Maximum number of vertices handled by the cache
+    ///
+    /// \see getVertexCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexCacheSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the vertex cache
+    ///
+    /// \return Maximum number of vertices handled by the cache
+    ///
+    /// \see setVertexCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCacheSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws that use the
+    /// same texture and blend mode are not sent to the graphics
+    /// card immediately: their vertices are transformed on the
+    /// CPU and accumulated into a single vertex stream, which is
+    /// rendered with one draw call when the render states change,
+    /// when the target is displayed, or when flush() is called.
+    ///
+    /// Since rendering is deferred, the textures used by pending
+    /// draws must not be modified or destroyed before the batch
+    /// is flushed. The textures that SFML manages internally,
+    /// such as the glyph atlases of sf::Font, are taken care of:
+    /// the targets whose pending batch uses one of them are
+    /// flushed before it is rewritten or released.
+    /// Draws that use a shader are never batched,
+    /// because SFML cannot know whether its parameters change
+    /// between two draws.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render all the pending batched primitives
+    ///
+    /// This function is called automatically when the render
+    /// states change, when the view changes, and when the target
+    /// is cleared, displayed or copied to a texture (including
+    /// through RenderWindow::capture). You only need to call it yourself
+    /// if you want to mix batched SFML drawing with direct OpenGL
+    /// calls or modify a texture that pending draws refer to.
+    ///
+    /// This function does nothing if batching is disabled or
+    /// if there is nothing to render.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering statistics of the target
+    ///
+    /// The statistics accumulate until resetStatistics() is
+    /// called; a typical usage is to read and reset them once
+    /// per frame.
+    ///
+    /// \return Statistics gathered since the last reset
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset all the rendering statistics to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -364,6 +527,24 @@ protected:
 
 private:
 
+    friend class DrawQueue;
+    friend class SpriteBatch;
+    friend class priv::GlyphAtlas;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the pending batches which use a texture
+    ///
+    /// This function is called before a texture that SFML
+    /// manages internally (like the glyph atlas of a font) is
+    /// modified or destroyed, so that the primitives already
+    /// batched are rendered with the texture they refer to.
+    /// All the targets which have batching enabled are checked.
+    ///
+    /// \param texture Texture about to be modified or destroyed
+    ///
+    ////////////////////////////////////////////////////////////
+    static void flushBatches(const Texture& texture);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -402,28 +583,129 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup environment for drawing
+    ///
+    /// \param useVertexCache Are we going to use the vertex cache?
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(bool useVertexCache, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup the source of the vertices to draw
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param stream      Copy the vertices to the stream buffer, if available,
+    ///                    instead of sourcing them from client memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupVertices(const Vertex* vertices, std::size_t vertexCount, bool stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the target renders with the core profile backend
+    ///
+    /// The target must be active. The OpenGL states are set
+    /// if needed, since this is when the backend is selected.
+    ///
+    /// \return True if the core profile backend is used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool usesCoreProfile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param firstVertex   Index of the first vertex to use when drawing
+    /// \param vertexCount   Number of vertices to use when drawing
+    /// \param instanceCount Number of instances of the primitives to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several instances of primitives with a single draw call
+    ///
+    /// Hardware instancing must be available, and the per-instance
+    /// vertex attributes must already be set up by the caller.
+    /// The shader of \a states is the one that reads them.
+    ///
+    /// \param vertices      Pointer to the vertices of one instance
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param instanceCount Number of instances to draw
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       std::size_t instanceCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clean up environment after drawing
+    ///
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupDraw(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the current batch
+    ///
+    /// The batch is flushed first if the primitives cannot
+    /// be merged with the ones that are already pending.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to append
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendToBatch(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
     ////////////////////////////////////////////////////////////
     struct StatesCache
     {
-        enum {VertexCacheSize = 4};
-
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        enum {DefaultVertexCacheSize = 4};
+
+        bool                glStatesSet;    ///< Are our internal GL states set yet?
+        bool                viewChanged;    ///< Has the current view changed since last draw?
+        BlendMode           lastBlendMode;  ///< Cached blending mode
+        Uint64              lastTextureId;  ///< Cached texture
+        bool                useVertexCache; ///< Did we previously use the vertex cache?
+        std::vector<Vertex> vertexCache;    ///< Pre-transformed vertices cache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending primitives of the automatic batching
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;   ///< Is batching enabled?
+        PrimitiveType       type;      ///< Type of the pending primitives (Points, Lines or Triangles)
+        BlendMode           blendMode; ///< Blend mode of the pending primitives
+        const Texture*      texture;   ///< Texture of the pending primitives
+        Uint64              textureId; ///< Cache identifier of the texture of the pending primitives
+        std::vector<Vertex> vertices;  ///< Pre-transformed pending vertices
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                m_defaultView;  ///< Default view
+    View                m_view;         ///< Current view
+    StatesCache         m_cache;        ///< Render states cache
+    Batch               m_batch;        ///< Pending batched primitives
+    Statistics          m_statistics;   ///< Rendering statistics
+    DrawQueue*          m_queue;        ///< Queue recording the draws instead of rendering them, if any
+    priv::CoreRenderer* m_coreRenderer; ///< Backend used when the context has a core profile, if any
+    priv::StreamBuffer* m_streamBuffer; ///< Ring buffer receiving the dynamic vertices, if supported
 };
 
 } // namespace sf
@@ -454,6 +736,24 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// Render targets can also batch draw calls automatically
+/// (see setBatchingEnabled): consecutive draws that share the
+/// same texture and blend mode are then merged into a single
+/// OpenGL draw call, which greatly reduces the CPU cost of
+/// scenes made of many small entities such as sprites.
+/// The getStatistics function reports how many draws were
+/// submitted and how many draw calls were actually issued.
+///
+/// When the OpenGL context was created with a core profile
+/// (sf::ContextSettings::Core), render targets automatically
+/// switch to a backend built on vertex buffers, vertex array
+/// objects and a built-in shader, since the fixed-function
+/// pipeline is not available there. sf::Shader cannot be used
+/// with this backend (except the distance field shader of
+/// sf::Font, which the built-in shader reproduces), and
+/// pushGLStates/popGLStates only make sure that SFML's own
+/// states are set again.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -37,6 +37,8 @@
 
 namespace sf
 {
+class ReadbackTicket;
+
 ////////////////////////////////////////////////////////////
 /// \brief Window that can serve as a target for 2D drawing
 ///
@@ -157,6 +159,33 @@ public:
     ////////////////////////////////////////////////////////////
     SFML_DEPRECATED Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the current contents of the window
+    ///        to an image, without waiting for the transfer
+    ///
+    /// The pending batched primitives are rendered first, then the
+    /// pixels are read directly from the window to a buffer owned
+    /// by \a ticket, without an intermediate texture, and this
+    /// function returns immediately. Poll the ticket on the next
+    /// frames and retrieve the pixels once it is ready.
+    ///
+    /// Call this function before display(), the contents of the
+    /// window are undefined after the buffers are swapped.
+    ///
+    /// This function fails if asynchronous readbacks are not
+    /// supported (see ReadbackTicket::isAvailable), if the window
+    /// can't be activated or if two readbacks are already pending
+    /// in \a ticket.
+    ///
+    /// \param ticket Ticket receiving the readback
+    ///
+    /// \return True if the readback was requested
+    ///
+    /// \see ReadbackTicket::retrieve
+    ///
+    ////////////////////////////////////////////////////////////
+    bool captureAsync(ReadbackTicket& ticket);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -177,6 +206,17 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void onResize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's buffers are swapped
+    ///
+    /// This function renders the primitives that are still
+    /// pending in the draw batch (see RenderTarget::setBatchingEnabled),
+    /// so that they are part of the displayed frame even when
+    /// display() is called through a sf::Window reference.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
 };
 
 } // namespace sf
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SAVETICKET_HPP
+#define SFML_SAVETICKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Pending save of an image on a background thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SaveTicket : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a ticket with no pending save.
+    ///
+    ////////////////////////////////////////////////////////////
+    SaveTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending save is not cancelled: the destructor waits
+    /// until the file is written.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SaveTicket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a save is pending
+    ///
+    /// A save remains pending until wait() is called.
+    ///
+    /// \return True if a save is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the file is written
+    ///
+    /// This function doesn't block, it is meant to be polled
+    /// once per frame. When it returns true, wait() doesn't
+    /// block either.
+    ///
+    /// \return True if no save is in progress
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the file is written
+    ///
+    /// The copy of the pixels is released.
+    ///
+    /// \return True if the file was saved, false if it failed or if no save was pending
+    ///
+    /// \see isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait();
+
+private:
+
+    friend class Image;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start saving a copy of pixels to a file
+    ///
+    /// The pending save, if any, is waited for first.
+    ///
+    /// \param filename Path of the file to save
+    /// \param pixels   Pixels of the image, copied
+    /// \param size     Size of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the saving thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread             m_thread;   ///< Thread writing the file
+    std::string        m_filename; ///< Path of the file to save
+    std::vector<Uint8> m_pixels;   ///< Copy of the pixels to save
+    Vector2u           m_size;     ///< Size of the image to save
+    mutable Mutex      m_mutex;    ///< Mutex protecting the state of the save
+    bool               m_pending;  ///< Is a save pending?
+    bool               m_done;     ///< Is the file written?
+    bool               m_success;  ///< Was the file saved successfully?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SAVETICKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SaveTicket
+/// \ingroup graphics
+///
+/// Encoding a large image takes time: saving a screenshot in
+/// the PNG format with sf::Image::saveToFile can freeze the
+/// application for a noticeable number of frames.
+///
+/// sf::Image::saveToFileAsync copies the pixels of the image
+/// and encodes them on a background thread. The save is
+/// tracked by a sf::SaveTicket: isReady() tells whether the
+/// file is written, and wait() returns the result of the save.
+///
+/// A ticket handles one save at a time; use several tickets to
+/// save several images at once.
+///
+/// Usage example (screenshots):
+/// \code
+/// sf::SaveTicket ticket;
+///
+/// if (screenshotRequested && ticket.isReady())
+/// {
+///     ticket.wait();
+///     sf::Image screenshot = texture.copyToImage();
+///     screenshot.saveToFileAsync(ticket, "screenshot.png");
+/// }
+/// \endcode
+///
+/// \see sf::Image
+///
+////////////////////////////////////////////////////////////
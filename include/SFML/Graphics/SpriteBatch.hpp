@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of sprites sharing the same texture,
+///        drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable, private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a source texture
+    ///
+    /// \param texture Source texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch(const SpriteBatch& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch& operator =(const SpriteBatch& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the batch
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// If the \a resetRect argument is true, the default texture
+    /// rect of the batch is automatically adjusted to the size
+    /// of the new texture. Instances that were already added keep
+    /// their own texture rectangle.
+    ///
+    /// \param texture   New texture
+    /// \param resetRect Should the default texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the batch
+    ///
+    /// If the batch has no source texture, a NULL pointer is returned.
+    ///
+    /// \return Pointer to the batch's texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the default sub-rectangle of the texture
+    ///
+    /// The default texture rect is given to the instances that
+    /// are added without an explicit texture rect.
+    ///
+    /// \param rectangle Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, append, resize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the default sub-rectangle of the texture
+    ///
+    /// \return Default texture rectangle of the instances
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of instances in the batch
+    ///
+    /// \return Number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getInstanceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the batch
+    ///
+    /// If \a instanceCount is greater than the current size, the
+    /// new instances get an identity transform, a white color and
+    /// the default texture rect. Otherwise the batch is truncated.
+    /// The allocated memory is never released, so that a batch
+    /// refilled every frame doesn't reallocate.
+    ///
+    /// \param instanceCount New number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the instances of the batch
+    ///
+    /// This function keeps the allocated memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an instance using the default texture rect
+    ///
+    /// \param transform Transform of the instance
+    /// \param color     Color of the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Transform& transform, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an instance
+    ///
+    /// \param transform   Transform of the instance
+    /// \param color       Color of the instance
+    /// \param textureRect Region of the texture displayed by the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Transform& transform, const Color& color, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the transform of an instance
+    ///
+    /// \param index     Index of the instance
+    /// \param transform New transform of the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransform(std::size_t index, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the array of transforms
+    ///
+    /// Transforms are stored as 6 consecutive floats per instance,
+    /// which are the two first rows of the 3x3 affine matrix:
+    /// {a00, a01, a02, a10, a11, a12}. A local point (x, y) of
+    /// the instance is mapped to (a00 * x + a01 * y + a02,
+    /// a10 * x + a11 * y + a12).
+    ///
+    /// The array contains getInstanceCount() * 6 elements and can
+    /// be filled directly, without going through sf::Transform.
+    /// The pointer is invalidated by resize, append and clear.
+    ///
+    /// \return Pointer to the transforms of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    float* getTransforms();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the array of transforms
+    ///
+    /// \return Pointer to the transforms of the instances
+    ///
+    /// \see getTransforms
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getTransforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the array of colors
+    ///
+    /// The array contains getInstanceCount() elements. The
+    /// pointer is invalidated by resize, append and clear.
+    ///
+    /// \return Pointer to the colors of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    Color* getColors();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the array of colors
+    ///
+    /// \return Pointer to the colors of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color* getColors() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the array of texture rectangles
+    ///
+    /// Texture rectangles are expressed in pixels. As with
+    /// sf::Sprite, the size of an instance in local coordinates
+    /// is the absolute size of its texture rectangle, and negative
+    /// sizes flip the displayed texture.
+    ///
+    /// The array contains getInstanceCount() elements. The
+    /// pointer is invalidated by resize, append and clear.
+    ///
+    /// \return Pointer to the texture rectangles of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect* getTextureRects();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the array of texture rectangles
+    ///
+    /// \return Pointer to the texture rectangles of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect* getTextureRects() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable hardware instancing
+    ///
+    /// Hardware instancing is enabled by default, and only
+    /// used if isInstancingAvailable() returns true. When it
+    /// is disabled, the instances are expanded on the CPU into
+    /// a single stream of vertices.
+    ///
+    /// \param enabled True to use hardware instancing when available
+    ///
+    /// \see isInstancingEnabled, isInstancingAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstancingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether hardware instancing is enabled
+    ///
+    /// \return True if hardware instancing is enabled
+    ///
+    /// \see setInstancingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isInstancingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports hardware instancing
+    ///
+    /// Hardware instancing requires shaders as well as the
+    /// ARB_draw_instanced and ARB_instanced_arrays extensions
+    /// (core since OpenGL 3.3).
+    ///
+    /// \return True if hardware instancing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the instances with a single instanced draw call
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    /// \return True on success, false if hardware instancing can't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool drawInstanced(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the instances into vertices and draw them
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawExpanded(RenderTarget& target, const RenderStates& states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the instancing shader if it doesn't exist yet
+    ///
+    /// \return True if the shader is ready to be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool ensureShader() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;           ///< Texture of the instances
+    IntRect                     m_textureRect;       ///< Default texture rectangle of new instances
+    std::vector<float>          m_transforms;        ///< Transforms of the instances, 6 floats each
+    std::vector<Color>          m_colors;            ///< Colors of the instances
+    std::vector<FloatRect>      m_textureRects;      ///< Texture rectangles of the instances
+    bool                        m_instancingEnabled; ///< Use hardware instancing when available?
+    mutable Shader*             m_shader;            ///< Shader reading the per-instance attributes (created on first use)
+    mutable int                 m_attributes[4];     ///< Locations of the per-instance attributes in the shader
+    mutable bool                m_shaderFailed;      ///< Did the creation of the shader fail?
+    mutable std::vector<Vertex> m_vertices;          ///< Vertices of the expanded instances, used when instancing is unavailable
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws a large number of textured quads that
+/// share the same texture and differ only by their transform,
+/// color and texture rectangle, such as particles or bullets.
+///
+/// Drawing thousands of individual sf::Sprite instances costs one
+/// draw call each. A sprite batch stores the per-instance data in
+/// separate contiguous arrays (structure of arrays), so that a
+/// simulation can write the transforms, colors and texture
+/// rectangles directly, and draws all the instances at once.
+///
+/// When the system supports it (see isInstancingAvailable()), the
+/// batch uses hardware instancing: a single unit quad is drawn
+/// once per instance with glDrawArraysInstanced, and the
+/// per-instance arrays are read by a built-in shader. Otherwise,
+/// or if a custom shader is given in the render states, the
+/// instances are expanded on the CPU into a single stream of
+/// triangles which is drawn with one draw call.
+///
+/// As with sf::Sprite, the texture must exist as long as the
+/// batch uses it, and the size of an instance is given by its
+/// texture rectangle.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("particle.png");
+///
+/// sf::SpriteBatch batch(texture);
+/// batch.resize(particles.size());
+///
+/// float* transforms = batch.getTransforms();
+/// sf::Color* colors = batch.getColors();
+/// for (std::size_t i = 0; i < particles.size(); ++i)
+/// {
+///     // Translation only
+///     float* t = transforms + i * 6;
+///     t[0] = 1; t[1] = 0; t[2] = particles[i].x;
+///     t[3] = 0; t[4] = 1; t[5] = particles[i].y;
+///     colors[i] = particles[i].color;
+/// }
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
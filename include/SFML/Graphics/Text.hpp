@@ -101,13 +101,33 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// Only the geometry of the lines following the first
+    /// modified character is recomputed, so that editing the
+    /// end of a long text remains cheap.
+    ///
     /// \param string New string
     ///
-    /// \see getString
+    /// \see getString, appendString
     ///
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a string to the end of the text's string
+    ///
+    /// This is equivalent to setString(getString() + string),
+    /// without comparing the two strings. Only the geometry of
+    /// the last line and of the new characters is computed,
+    /// which makes this function well suited to texts that
+    /// keep growing, such as logs or consoles.
+    ///
+    /// \param string String to append
+    ///
+    /// \see setString, getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendString(const String& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -361,6 +381,8 @@ public:
 
 private:
 
+    friend class TextBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -379,6 +401,31 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the layout at the start of a line
+    ///
+    /// It allows to resume the computation of the geometry
+    /// from the line containing the first modified character.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LineState
+    {
+        std::size_t index;              ///< Index of the first character of the line
+        std::size_t vertexCount;        ///< Number of fill vertices of the previous lines
+        std::size_t outlineVertexCount; ///< Number of outline vertices of the previous lines
+        float       y;                  ///< Vertical position of the line
+        Uint32      prevChar;           ///< Character preceding the line, for kerning
+        float       minX;               ///< Left of the bounds of the previous lines
+        float       minY;               ///< Top of the bounds of the previous lines
+        float       maxX;               ///< Right of the bounds of the previous lines
+        float       maxY;               ///< Bottom of the bounds of the previous lines
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<LineState> LineTable; ///< Layout state at the start of each line
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -393,6 +440,9 @@ private:
     mutable VertexArray m_outlineVertices;    ///< Vertex array containing the outline geometry
     mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
     mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    mutable Uint64      m_fontGeneration;     ///< Generation of the font glyphs, to detect evicted glyphs
+    mutable LineTable   m_lines;              ///< Layout state at the start of each line of the geometry
+    mutable std::size_t m_validLength;        ///< Number of leading characters whose geometry is up to date
 };
 
 } // namespace sf
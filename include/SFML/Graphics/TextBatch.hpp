@@ -0,0 +1,458 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTBATCH_HPP
+#define SFML_TEXTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of text runs sharing the same font,
+///        drawn with a few draw calls
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no font.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a font
+    ///
+    /// \param font Font used to draw the runs
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextBatch(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch(const TextBatch& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch& operator =(const TextBatch& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font of the batch
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the font, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// All the runs of the batch use this font.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font of the batch
+    ///
+    /// If the batch has no font, a NULL pointer is returned.
+    ///
+    /// \return Pointer to the batch's font
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of runs in the batch
+    ///
+    /// \return Number of runs
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRunCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a run of text
+    ///
+    /// The other attributes of the run have the same default
+    /// values as sf::Text, and can be changed with the
+    /// functions taking the index of the run.
+    ///
+    /// \param string        Text displayed by the run
+    /// \param position      Position of the run
+    /// \param characterSize Base size of characters, in pixels
+    /// \param color         Fill color of the run
+    ///
+    /// \return Index of the new run
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t append(const String& string, const Vector2f& position, unsigned int characterSize = 30, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the runs of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the string of a run
+    ///
+    /// \param index  Index of the run
+    /// \param string New string
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(std::size_t index, const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the string of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return String of the run
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getString(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a run
+    ///
+    /// \param index    Index of the run
+    /// \param position New position
+    ///
+    /// \see getPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Position of the run
+    ///
+    /// \see setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size of a run
+    ///
+    /// Runs with different character sizes use different font
+    /// textures, unless the font shares a single texture for all
+    /// the sizes (see Font::setSharedAtlasEnabled).
+    ///
+    /// \param index Index of the run
+    /// \param size  New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(std::size_t index, unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    /// \see setCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the style of a run
+    ///
+    /// \param index Index of the run
+    /// \param style New style, a combination of sf::Text::Style flags
+    ///
+    /// \see getStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(std::size_t index, Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the style of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Style of the run
+    ///
+    /// \see setStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of a run
+    ///
+    /// \param index Index of the run
+    /// \param color New fill color
+    ///
+    /// \see getFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Fill color of the run
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline color of a run
+    ///
+    /// \param index Index of the run
+    /// \param color New outline color
+    ///
+    /// \see getOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Outline color of the run
+    ///
+    /// \see setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the outline of a run
+    ///
+    /// \param index     Index of the run
+    /// \param thickness New outline thickness, in pixels
+    ///
+    /// \see getOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineThickness(std::size_t index, float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline thickness of a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Outline thickness of the run, in pixels
+    ///
+    /// \see setOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOutlineThickness(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of a run
+    ///
+    /// The rectangle is the global bounding rectangle that an
+    /// sf::Text with the same attributes would have.
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Bounding rectangle of the run
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getRunBounds(std::size_t index) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the geometry of the pages is updated
+    ///
+    /// Only the runs which changed, or whose glyphs were evicted
+    /// from the font, are recomputed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page storing the glyphs of a character size
+    ///
+    /// \param characterSize Character size
+    ///
+    /// \return Key of the page in the page table
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageKey(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the pages, so that they are rebuilt on next draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetPages();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    struct Run
+    {
+        Run();
+
+        Text         text;               ///< Text computing the geometry of the run, in local coordinates
+        unsigned int page;               ///< Key of the page containing the run
+        bool         paged;              ///< Has the run been added to a page?
+        bool         dirty;              ///< Must the geometry of the run be updated?
+        std::size_t  offset;             ///< Index of the first fill vertex of the run in its page
+        std::size_t  vertexCount;        ///< Number of fill vertices of the run in its page
+        std::size_t  outlineOffset;      ///< Index of the first outline vertex of the run in its page
+        std::size_t  outlineVertexCount; ///< Number of outline vertices of the run in its page
+    };
+
+    struct Page
+    {
+        Page();
+
+        std::vector<std::size_t> runs;            ///< Indices of the runs of the page, in drawing order
+        std::vector<std::size_t> updated;         ///< Indices of the runs whose vertices changed in place
+        std::vector<Vertex>      vertices;        ///< Fill vertices of all the runs
+        std::vector<Vertex>      outlineVertices; ///< Outline vertices of all the runs
+        VertexBuffer             buffer;          ///< Fill vertices, in graphics memory
+        VertexBuffer             outlineBuffer;   ///< Outline vertices, in graphics memory
+        Uint64                   generation;      ///< Generation of the font glyphs used by the vertices
+        bool                     layoutDirty;     ///< Must all the vertices of the page be rebuilt?
+    };
+
+    typedef std::vector<Run>             RunList;   ///< List of text runs
+    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a page key to its vertices
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*       m_font;  ///< Font used to display the runs
+    mutable RunList   m_runs;  ///< Runs of text
+    mutable PageTable m_pages; ///< Vertices of the runs, grouped by font texture
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextBatch
+/// \ingroup graphics
+///
+/// sf::TextBatch draws many runs of text that share the same
+/// font, such as labels or damage numbers, without paying one
+/// or two draw calls per sf::Text.
+///
+/// Each run has the attributes of a sf::Text: string, position,
+/// character size, style, fill color and outline, and produces
+/// exactly the same geometry. The vertices of all the runs that
+/// use the same font texture (a "page", one per character size
+/// unless the font shares its atlas) are stored together in a
+/// single vertex buffer. When a run changes, only its own
+/// geometry is recomputed; if its number of vertices didn't
+/// change, only its part of the buffer is uploaded again.
+///
+/// The outlines of all the runs are drawn first, then their
+/// fill, which makes two draw calls per page: two draw calls in
+/// total when all the runs use the same character size or when
+/// the font uses a shared atlas. Contrary to individual texts,
+/// the outline of a run therefore never covers the fill of
+/// another one.
+///
+/// Usage example:
+/// \code
+/// sf::Font font;
+/// font.loadFromFile("arial.ttf");
+/// font.setSharedAtlasEnabled(true);
+///
+/// sf::TextBatch labels(font);
+/// for (std::size_t i = 0; i < units.size(); ++i)
+/// {
+///     std::size_t run = labels.append(units[i].name, units[i].position, 14);
+///     labels.setOutlineThickness(run, 1.f);
+///     labels.setOutlineColor(run, sf::Color::Black);
+/// }
+///
+/// // Every frame, update the runs which moved
+/// for (std::size_t i = 0; i < units.size(); ++i)
+///     labels.setPosition(i, units[i].position);
+///
+/// window.draw(labels);
+/// \endcode
+///
+/// \see sf::Text, sf::Font, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
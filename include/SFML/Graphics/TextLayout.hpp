@@ -0,0 +1,402 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTLAYOUT_HPP
+#define SFML_TEXTLAYOUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/String.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+class VertexArray;
+
+////////////////////////////////////////////////////////////
+/// \brief Layout of a string in lines of glyphs, with
+///        optional word wrapping
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextLayout
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layout.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the layout of a string
+    ///
+    /// \param string        String to lay out
+    /// \param font          Font used to lay out the string
+    /// \param characterSize Base size of characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout(const String& string, const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the string to lay out
+    ///
+    /// \param string New string
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font used to lay out the string
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the layout uses it.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size
+    ///
+    /// The default size is 30.
+    ///
+    /// \param size New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the style of the text
+    ///
+    /// The styles are the ones of sf::Text (sf::Text::Bold,
+    /// sf::Text::Italic, ...). The default style is
+    /// sf::Text::Regular.
+    ///
+    /// \param style New style
+    ///
+    /// \see getStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum width of the lines
+    ///
+    /// Lines longer than \a width are broken after the last
+    /// space or tabulation that fits; a word longer than
+    /// \a width on its own is broken between two characters.
+    /// A width of 0 disables wrapping, which is the default:
+    /// lines are then only broken at '\\n' characters.
+    ///
+    /// \param width Maximum width of the lines, in pixels
+    ///
+    /// \see getWrapWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setWrapWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the string laid out
+    ///
+    /// \return String of the layout
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font used to lay out the string
+    ///
+    /// \return Pointer to the font, or NULL if there's none
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    /// \see setCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the style of the text
+    ///
+    /// \return Style of the text
+    ///
+    /// \see setStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum width of the lines
+    ///
+    /// \return Maximum width of the lines, in pixels (0 if wrapping is disabled)
+    ///
+    /// \see setWrapWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    float getWrapWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of lines
+    ///
+    /// An empty string has one empty line.
+    ///
+    /// \return Number of lines
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the first character of a line
+    ///
+    /// \param line Index of the line
+    ///
+    /// \return Index of the first character of the line (the size of the string if out of range)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineStart(std::size_t line) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width of a line
+    ///
+    /// Whitespace at the end of the line is not counted.
+    ///
+    /// \param line Index of the line
+    ///
+    /// \return Width of the line, in pixels (0 if out of range)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineWidth(std::size_t line) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the line containing a character
+    ///
+    /// This function performs a binary search on the lines.
+    ///
+    /// \param index Index of the character
+    ///
+    /// \return Index of the line (the last one if \a index is out of range)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findLine(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the line at a vertical position
+    ///
+    /// \param y Vertical position, in local coordinates
+    ///
+    /// \return Index of the line (clamped to the existing lines)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findLineAt(float y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the position of the \a index-th character
+    ///
+    /// The position is the one of the top-left corner of the
+    /// character's cell, in local coordinates: the top of the
+    /// first line is 0, like in sf::Text. If \a index is out of
+    /// range, the position of the end of the string is returned.
+    ///
+    /// \param index Index of the character
+    ///
+    /// \return Position of the character
+    ///
+    /// \see findCharacterIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f findCharacterPos(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the character closest to a position
+    ///
+    /// This is the inverse of findCharacterPos, meant for
+    /// placing a cursor: the returned index is the one of the
+    /// character boundary closest to \a position, on the line
+    /// at \a position. Both the line and the character are
+    /// found with binary searches.
+    ///
+    /// \param position Position, in local coordinates
+    ///
+    /// \return Index of the character
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCharacterIndex(const Vector2f& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the layout
+    ///
+    /// The rectangle starts at (0, 0), its width is the one of
+    /// the longest line and its height is the number of lines
+    /// multiplied by the line spacing of the font.
+    ///
+    /// \return Bounding rectangle of the layout, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the triangles of a range of lines to a vertex array
+    ///
+    /// The vertices are appended to \a vertices, whose primitive
+    /// type must be sf::Triangles; they must be drawn with the
+    /// texture of the font for the character size of the layout
+    /// (and its distance field shader, if enabled).
+    /// Only the glyphs of the requested lines are generated, so
+    /// that a long document can be displayed by generating its
+    /// visible lines only.
+    ///
+    /// Call this function twice to draw outlined text: first
+    /// with the outline color and thickness, then with the fill
+    /// color and no outline.
+    ///
+    /// \param vertices         Vertex array receiving the triangles
+    /// \param firstLine        Index of the first line to add
+    /// \param lineCount        Number of lines to add
+    /// \param color            Color of the glyphs
+    /// \param outlineThickness Thickness of the outline (when != 0 the glyphs are not filled)
+    ///
+    ////////////////////////////////////////////////////////////
+    void getVertices(VertexArray& vertices, std::size_t firstLine, std::size_t lineCount, const Color& color = Color::White, float outlineThickness = 0) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Line of the layout
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t start; ///< Index of the first character of the line
+        float       width; ///< Width of the line, without trailing whitespace
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the layout is updated
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureLayoutUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertical distance between two lines
+    ///
+    /// \return Line spacing, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineSpacing() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    String                     m_string;           ///< String to lay out
+    const Font*                m_font;             ///< Font used to lay out the string
+    unsigned int               m_characterSize;    ///< Base size of characters, in pixels
+    Uint32                     m_style;            ///< Text style (see sf::Text::Style)
+    float                      m_wrapWidth;        ///< Maximum width of the lines (0 for no wrapping)
+    mutable std::vector<float> m_positions;        ///< Horizontal position of each character, and of the end of the string
+    mutable std::vector<Line>  m_lines;            ///< Lines of the layout
+    mutable float              m_width;            ///< Width of the longest line
+    mutable bool               m_layoutNeedUpdate; ///< Does the layout need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTLAYOUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextLayout
+/// \ingroup graphics
+///
+/// sf::TextLayout computes where each character of a string
+/// goes, once, and stores it in a compact form: one horizontal
+/// position per character, plus a table of lines. Lines are
+/// broken at '\\n' characters and, if a wrap width is set,
+/// between words.
+///
+/// Once the layout is computed, finding the position of a
+/// character, or the character under a position (to place a
+/// cursor after a mouse click, for example), only requires
+/// binary searches instead of walking the whole string as
+/// sf::Text::findCharacterPos does. The layout can also
+/// generate the vertices of a range of lines only, which
+/// keeps the cost of displaying a long document proportional
+/// to the visible part.
+///
+/// sf::TextLayout is not drawable itself: it fills vertex
+/// arrays, which are drawn with the texture of the font.
+///
+/// Usage example:
+/// \code
+/// sf::TextLayout layout(document, font, 16);
+/// layout.setWrapWidth(600);
+///
+/// // Generate the visible lines
+/// std::size_t first = layout.findLineAt(scroll);
+/// std::size_t last  = layout.findLineAt(scroll + viewHeight);
+/// sf::VertexArray vertices(sf::Triangles);
+/// layout.getVertices(vertices, first, last - first + 1, sf::Color::Black);
+///
+/// sf::RenderStates states;
+/// states.texture = &font.getTexture(16);
+/// states.transform.translate(0, -scroll);
+/// window.draw(vertices, states);
+///
+/// // Place the cursor where the user clicked
+/// std::size_t cursor = layout.findCharacterIndex(sf::Vector2f(clickX, clickY + scroll));
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
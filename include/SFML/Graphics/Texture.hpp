@@ -38,6 +38,7 @@ namespace sf
 class Window;
 class RenderTarget;
 class RenderTexture;
+class ReadbackTicket;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -95,6 +96,29 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the texture, keeping its content
+    ///
+    /// The current pixels are copied to the top-left corner of
+    /// the resized texture, and the new area is filled with
+    /// \a color. The copy is done by the graphics card (through
+    /// a framebuffer object), so growing a texture doesn't need
+    /// to read its pixels back; it falls back to copyToImage if
+    /// framebuffer objects are not supported.
+    ///
+    /// The texture must have been created, and it can't be the
+    /// texture of a sf::RenderTexture. If this function fails,
+    /// the texture is left unchanged.
+    ///
+    /// \param width  New width of the texture
+    /// \param height New height of the texture
+    /// \param color  Color of the new pixels
+    ///
+    /// \return True if resizing was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resize(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0, 0));
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
     ///
@@ -236,6 +260,27 @@ public:
     ////////////////////////////////////////////////////////////
     Image copyToImage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the texture pixels to an image,
+    ///        without waiting for the transfer
+    ///
+    /// The pixels are transferred to a buffer owned by \a ticket,
+    /// and this function returns immediately. Poll the ticket on
+    /// the next frames and retrieve the pixels once it is ready.
+    ///
+    /// This function fails if asynchronous readbacks are not
+    /// supported (see ReadbackTicket::isAvailable), if the texture
+    /// is empty or if two readbacks are already pending in \a ticket.
+    ///
+    /// \param ticket Ticket receiving the readback
+    ///
+    /// \return True if the readback was requested
+    ///
+    /// \see copyToImage, ReadbackTicket::retrieve
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyToImageAsync(ReadbackTicket& ticket) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the whole texture from an array of pixels
     ///
@@ -325,6 +370,9 @@ public:
     /// passing a window bigger than the texture will lead to an
     /// undefined behavior.
     ///
+    /// If the window is a sf::RenderWindow, the primitives still
+    /// pending in its draw batch are rendered before the copy.
+    ///
     /// This function does nothing if either the texture or the window
     /// was not previously created.
     ///
@@ -340,6 +388,9 @@ public:
     /// passing an invalid combination of window size and offset
     /// will lead to an undefined behavior.
     ///
+    /// If the window is a sf::RenderWindow, the primitives still
+    /// pending in its draw batch are rendered before the copy.
+    ///
     /// This function does nothing if either the texture or the window
     /// was not previously created.
     ///
@@ -350,6 +401,99 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Window& window, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an array of pixels,
+    ///        without waiting for the transfer
+    ///
+    /// The pixels are copied to a pixel buffer object owned by
+    /// the texture, and the transfer to the texture is queued:
+    /// the function returns without waiting for the driver, and
+    /// without the glFlush that update() performs. The \a pixels
+    /// array can be reused as soon as the function returns.
+    /// isUpdateComplete() tells when the transfer is done, and
+    /// flushUpdates() makes it start right away.
+    ///
+    /// Drawing the texture in the same thread always shows the
+    /// new pixels. To use them in another thread, call
+    /// flushUpdates() first.
+    ///
+    /// If pixel buffer objects are not supported (see
+    /// isAsyncUpdateAvailable), the texture is updated directly,
+    /// without the glFlush.
+    ///
+    /// The arguments are the same as the ones of update(): no
+    /// additional check is performed, and this function does
+    /// nothing if \a pixels is null or if the texture was not
+    /// previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    /// \see isUpdateComplete, flushUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an image,
+    ///        without waiting for the transfer
+    ///
+    /// See updateAsync(const Uint8*, unsigned int, unsigned int, unsigned int, unsigned int).
+    ///
+    /// \param image Image to copy to the texture
+    /// \param x     X offset in the texture where to copy the source image
+    /// \param y     Y offset in the texture where to copy the source image
+    ///
+    /// \see isUpdateComplete, flushUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAsync(const Image& image, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last asynchronous update is done
+    ///
+    /// This function doesn't block. If sync objects are not
+    /// supported, the state of the transfer can't be known and
+    /// this function always returns true.
+    ///
+    /// \return True if no asynchronous update is still pending
+    ///
+    /// \see updateAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isUpdateComplete() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the pending texture updates of the calling thread
+    ///
+    /// update() calls glFlush after every transfer so that the new
+    /// pixels are immediately visible in all the contexts, which
+    /// blocks the CPU until the driver has processed the commands.
+    /// updateAsync() doesn't, so that many updates can be queued
+    /// at once: call this function once they are all queued, to
+    /// send them to the GPU and make them visible to the other
+    /// threads.
+    ///
+    /// \see updateAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static void flushUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous updates
+    ///
+    /// Asynchronous updates need pixel buffer objects. When they
+    /// are not available, updateAsync() updates the texture
+    /// directly.
+    ///
+    /// \return True if asynchronous updates are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAsyncUpdateAvailable();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -569,16 +713,18 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u      m_size;          ///< Public texture size
+    Vector2u      m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    unsigned int  m_texture;       ///< Internal texture identifier
+    bool          m_isSmooth;      ///< Status of the smooth filter
+    bool          m_sRgb;          ///< Should the texture source be converted from sRGB?
+    bool          m_isRepeated;    ///< Is the texture in repeat mode?
+    mutable bool  m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool          m_fboAttachment; ///< Is this texture owned by a framebuffer object?
+    bool          m_hasMipmap;     ///< Has the mipmap been generated?
+    Uint64        m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    unsigned int  m_pixelBuffer;   ///< Pixel buffer object used by the asynchronous updates
+    mutable void* m_uploadFence;   ///< Fence signaled when the last asynchronous update is done
 };
 
 } // namespace sf
@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of images packed into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an image stored in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    static const Handle InvalidHandle; ///< Handle that never refers to an image
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty atlas, with pages of 1024x1024 pixels.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the pages created from now on
+    ///
+    /// Larger pages allow more images to share the same texture,
+    /// and therefore to be drawn together. The size is clamped
+    /// to Texture::getMaximumSize(). An image that is larger
+    /// than the page size gets a page of its own.
+    ///
+    /// \param size Width and height of the new pages, in pixels
+    ///
+    /// \see getPageSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPageSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the pages created from now on
+    ///
+    /// \return Width and height of the new pages, in pixels
+    ///
+    /// \see setPageSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The \a area argument can be used to add only a sub-rectangle
+    /// of the image. If the \a area rectangle crosses the bounds
+    /// of the image, it is adjusted to fit the image size.
+    /// An empty area (the default) adds the whole image.
+    ///
+    /// \param image Image to copy into the atlas
+    /// \param area  Area of the image to copy
+    ///
+    /// \return Handle of the new entry, or InvalidHandle on failure
+    ///
+    /// \see addFromFile, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle add(const Image& image, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file and add it to the atlas
+    ///
+    /// See Image::loadFromFile for the list of supported formats.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Handle of the new entry, or InvalidHandle on failure
+    ///
+    /// \see add, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle addFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an image from the atlas
+    ///
+    /// The space of the image is made available for the next
+    /// insertions, and the handle becomes invalid. Removing an
+    /// invalid handle has no effect.
+    ///
+    /// \param handle Handle of the image to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and destroy the pages
+    ///
+    /// All the handles become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a handle refers to an image of the atlas
+    ///
+    /// \param handle Handle to check
+    ///
+    /// \return True if the image exists, false if it was removed or never existed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture containing an image
+    ///
+    /// The handle must be valid. The returned texture stays the
+    /// same for the whole life of the image.
+    ///
+    /// \param handle Handle of the image
+    ///
+    /// \return Texture of the page that contains the image
+    ///
+    /// \see getTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of an image in its texture
+    ///
+    /// The result can be passed directly to Sprite::setTextureRect.
+    /// An empty rectangle is returned if the handle is invalid.
+    ///
+    /// \param handle Handle of the image
+    ///
+    /// \return Area of the image in the texture returned by getTexture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTextureRect(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images stored in the atlas
+    ///
+    /// \return Number of images
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getImageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages (textures) of the atlas
+    ///
+    /// \return Number of pages
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// \param index Index of the page, in [0, getPageCount()[
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPageTexture(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of the pages covered by images
+    ///
+    /// Padding between the images doesn't count as used space.
+    ///
+    /// \return Occupancy, in [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOccupancy() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all the pages
+    ///
+    /// A transparent pixel of padding is kept around each image,
+    /// so that smoothing doesn't make them bleed on each other.
+    /// The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+private:
+
+    struct Page;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image stored in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint32       generation; ///< Incremented each time the slot is reused, to invalidate old handles
+        bool         used;       ///< Does the slot refer to an image?
+        std::size_t  page;       ///< Index of the page containing the image
+        IntRect      rect;       ///< Area of the image in the page
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the entry referred to by a handle
+    ///
+    /// \param handle Handle of the image
+    ///
+    /// \return Pointer to the entry, or NULL if the handle is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entry* findEntry(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Page*>       m_pages;     ///< Pages of the atlas
+    std::vector<Entry>       m_entries;   ///< Slots of the images, indexed by handle
+    std::vector<std::size_t> m_freeSlots; ///< Indices of the unused slots
+    std::size_t              m_count;     ///< Number of images in the atlas
+    unsigned int             m_pageSize;  ///< Size of the new pages
+    bool                     m_isSmooth;  ///< Status of the smooth filter
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Every sf::Texture is a separate OpenGL texture, and draws
+/// that use different textures can't be batched together.
+/// sf::TextureAtlas packs many small images into a few large
+/// textures (the pages of the atlas), so that sprites that
+/// display them share the same texture.
+///
+/// Images can be added and removed at any time. Each image is
+/// identified by a handle, which gives access to the texture
+/// and the texture rectangle of the image; both stay the same
+/// until the image is removed. The space of removed images is
+/// reused by the next insertions, and getOccupancy() tells how
+/// much of the pages is actually covered by images.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+/// sf::TextureAtlas::Handle player = atlas.addFromFile("player.png");
+/// sf::TextureAtlas::Handle enemy = atlas.addFromFile("enemy.png");
+/// if ((player == sf::TextureAtlas::InvalidHandle) || (enemy == sf::TextureAtlas::InvalidHandle))
+///     return -1;
+///
+/// sf::Sprite sprite(atlas.getTexture(player), atlas.getTextureRect(player));
+/// ...
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
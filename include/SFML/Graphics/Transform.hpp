@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -118,6 +119,43 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// This function gives the same result as calling
+    /// transformPoint on every point, but it processes several
+    /// points at once using the vector instructions of the CPU
+    /// (SSE2 or NEON) when they are available.
+    /// \a input and \a output may point to the same array.
+    ///
+    /// \param input  Points to transform
+    /// \param output Array receiving the transformed points
+    /// \param count  Number of points to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points stored with a stride
+    ///
+    /// This overload allows to transform points that are
+    /// interleaved with other data, for example the positions
+    /// of an array of sf::Vertex:
+    /// \code
+    /// transform.transformPoints(&vertices[0].position, sizeof(sf::Vertex),
+    ///                           &vertices[0].position, sizeof(sf::Vertex), count);
+    /// \endcode
+    ///
+    /// \param input        First point to transform
+    /// \param inputStride  Distance in bytes between two consecutive input points
+    /// \param output       First transformed point
+    /// \param outputStride Distance in bytes between two consecutive output points
+    /// \param count        Number of points to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* input, std::size_t inputStride,
+                         Vector2f* output, std::size_t outputStride, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
@@ -38,6 +38,7 @@
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/OutputStream.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Thread.hpp>
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OUTPUTSTREAM_HPP
+#define SFML_OUTPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract class for custom file output streams
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API OutputStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~OutputStream() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write data to the stream
+    ///
+    /// The data is written sequentially: each call appends it
+    /// after the data written by the previous one.
+    ///
+    /// \param data Buffer containing the data to write
+    /// \param size Number of bytes to write
+    ///
+    /// \return The number of bytes actually written, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 write(const void* data, Int64 size) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_OUTPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OutputStream
+/// \ingroup system
+///
+/// This class allows users to define their own file output
+/// destinations to which SFML can save resources.
+///
+/// SFML resource classes like sf::Image provide saveToFile
+/// and saveToMemory functions, which write data to conventional
+/// destinations. However, if you want to send data somewhere
+/// else (over a network, to an archive, encrypted, etc) you can
+/// derive your own class from sf::OutputStream and save SFML
+/// resources with their saveToStream function. The data is
+/// written in small chunks, as it is produced, so the whole
+/// file never has to be held in memory.
+///
+/// Usage example:
+/// \code
+/// // custom stream class that writes to a socket
+/// class SocketStream : public sf::OutputStream
+/// {
+/// public:
+///
+///     SocketStream(sf::TcpSocket& socket);
+///
+///     Int64 write(const void* data, Int64 size);
+///
+/// private:
+///
+///     ...
+/// };
+///
+/// // now you can send screenshots...
+/// SocketStream stream(socket);
+/// image.saveToStream(stream, "png");
+///
+/// // etc.
+/// \endcode
+///
+////////////////////////////////////////////////////////////
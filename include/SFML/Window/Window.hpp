@@ -497,6 +497,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's buffers are swapped
+    ///
+    /// This function is called so that derived classes can
+    /// finish their rendering of the current frame before
+    /// it is shown on screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,714 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CoreRenderer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if !defined(GL_MAJOR_VERSION)
+    #define GL_MAJOR_VERSION 0x821B
+#endif
+
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+#if !defined(GL_TEXTURE0)
+    #define GL_TEXTURE0 0x84C0
+#endif
+
+#if !defined(GL_ARRAY_BUFFER)
+    #define GL_ARRAY_BUFFER 0x8892
+#endif
+
+#if !defined(GL_ELEMENT_ARRAY_BUFFER)
+    #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+
+#if !defined(GL_STREAM_DRAW)
+    #define GL_STREAM_DRAW 0x88E0
+#endif
+
+#if !defined(GL_STATIC_DRAW)
+    #define GL_STATIC_DRAW 0x88E4
+#endif
+
+#if !defined(GL_FRAGMENT_SHADER)
+    #define GL_FRAGMENT_SHADER 0x8B30
+#endif
+
+#if !defined(GL_VERTEX_SHADER)
+    #define GL_VERTEX_SHADER 0x8B31
+#endif
+
+#if !defined(GL_COMPILE_STATUS)
+    #define GL_COMPILE_STATUS 0x8B81
+#endif
+
+#if !defined(GL_LINK_STATUS)
+    #define GL_LINK_STATUS 0x8B82
+#endif
+
+
+namespace
+{
+    sf::Mutex functionsMutex;
+
+    // Core OpenGL 3.2 entry points used by the renderer; they are not
+    // part of any extension, so the extension loader doesn't provide them
+    struct CoreFunctions
+    {
+        void   (GL_FUNCPTR *activeTexture)(GLenum);
+        GLuint (GL_FUNCPTR *createShader)(GLenum);
+        void   (GL_FUNCPTR *shaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*);
+        void   (GL_FUNCPTR *compileShader)(GLuint);
+        void   (GL_FUNCPTR *getShaderiv)(GLuint, GLenum, GLint*);
+        void   (GL_FUNCPTR *getShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+        void   (GL_FUNCPTR *deleteShader)(GLuint);
+        GLuint (GL_FUNCPTR *createProgram)();
+        void   (GL_FUNCPTR *attachShader)(GLuint, GLuint);
+        void   (GL_FUNCPTR *bindAttribLocation)(GLuint, GLuint, const GLchar*);
+        void   (GL_FUNCPTR *linkProgram)(GLuint);
+        void   (GL_FUNCPTR *getProgramiv)(GLuint, GLenum, GLint*);
+        void   (GL_FUNCPTR *getProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+        void   (GL_FUNCPTR *deleteProgram)(GLuint);
+        void   (GL_FUNCPTR *useProgram)(GLuint);
+        GLint  (GL_FUNCPTR *getUniformLocation)(GLuint, const GLchar*);
+        void   (GL_FUNCPTR *uniform1i)(GLint, GLint);
+        void   (GL_FUNCPTR *uniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+        void   (GL_FUNCPTR *genBuffers)(GLsizei, GLuint*);
+        void   (GL_FUNCPTR *bindBuffer)(GLenum, GLuint);
+        void   (GL_FUNCPTR *bufferData)(GLenum, GLsizeiptrARB, const void*, GLenum);
+        void   (GL_FUNCPTR *bufferSubData)(GLenum, GLintptrARB, GLsizeiptrARB, const void*);
+        void   (GL_FUNCPTR *deleteBuffers)(GLsizei, const GLuint*);
+        void   (GL_FUNCPTR *genVertexArrays)(GLsizei, GLuint*);
+        void   (GL_FUNCPTR *bindVertexArray)(GLuint);
+        void   (GL_FUNCPTR *deleteVertexArrays)(GLsizei, const GLuint*);
+        void   (GL_FUNCPTR *enableVertexAttribArray)(GLuint);
+        void   (GL_FUNCPTR *vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+    };
+
+    CoreFunctions core;
+
+    template <typename T>
+    bool loadFunction(T& function, const char* name)
+    {
+        function = reinterpret_cast<T>(sf::Context::getFunction(name));
+        return function != NULL;
+    }
+
+    // Load the core entry points, the context must be active
+    bool loadCoreFunctions()
+    {
+        sf::Lock lock(functionsMutex);
+
+        static bool loaded = false;
+        static bool success = false;
+
+        if (!loaded)
+        {
+            loaded = true;
+            success = loadFunction(core.activeTexture,           "glActiveTexture") &&
+                      loadFunction(core.createShader,            "glCreateShader") &&
+                      loadFunction(core.shaderSource,            "glShaderSource") &&
+                      loadFunction(core.compileShader,           "glCompileShader") &&
+                      loadFunction(core.getShaderiv,             "glGetShaderiv") &&
+                      loadFunction(core.getShaderInfoLog,        "glGetShaderInfoLog") &&
+                      loadFunction(core.deleteShader,            "glDeleteShader") &&
+                      loadFunction(core.createProgram,           "glCreateProgram") &&
+                      loadFunction(core.attachShader,            "glAttachShader") &&
+                      loadFunction(core.bindAttribLocation,      "glBindAttribLocation") &&
+                      loadFunction(core.linkProgram,             "glLinkProgram") &&
+                      loadFunction(core.getProgramiv,            "glGetProgramiv") &&
+                      loadFunction(core.getProgramInfoLog,       "glGetProgramInfoLog") &&
+                      loadFunction(core.deleteProgram,           "glDeleteProgram") &&
+                      loadFunction(core.useProgram,              "glUseProgram") &&
+                      loadFunction(core.getUniformLocation,      "glGetUniformLocation") &&
+                      loadFunction(core.uniform1i,               "glUniform1i") &&
+                      loadFunction(core.uniformMatrix4fv,        "glUniformMatrix4fv") &&
+                      loadFunction(core.genBuffers,              "glGenBuffers") &&
+                      loadFunction(core.bindBuffer,              "glBindBuffer") &&
+                      loadFunction(core.bufferData,              "glBufferData") &&
+                      loadFunction(core.bufferSubData,           "glBufferSubData") &&
+                      loadFunction(core.deleteBuffers,           "glDeleteBuffers") &&
+                      loadFunction(core.genVertexArrays,         "glGenVertexArrays") &&
+                      loadFunction(core.bindVertexArray,         "glBindVertexArray") &&
+                      loadFunction(core.deleteVertexArrays,      "glDeleteVertexArrays") &&
+                      loadFunction(core.enableVertexAttribArray, "glEnableVertexAttribArray") &&
+                      loadFunction(core.vertexAttribPointer,     "glVertexAttribPointer");
+        }
+
+        return success;
+    }
+
+    // Locations of the vertex attributes, bound before linking
+    enum
+    {
+        PositionAttribute  = 0,
+        ColorAttribute     = 1,
+        TexCoordsAttribute = 2
+    };
+
+    const char* vertexShaderSource =
+        "#version 150\n"
+        "uniform mat4 projectionMatrix;\n"
+        "uniform mat4 modelViewMatrix;\n"
+        "uniform mat4 textureMatrix;\n"
+        "in vec2 position;\n"
+        "in vec4 color;\n"
+        "in vec2 texCoords;\n"
+        "out vec4 vertexColor;\n"
+        "out vec2 vertexTexCoords;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = projectionMatrix * modelViewMatrix * vec4(position, 0.0, 1.0);\n"
+        "    vertexColor = color;\n"
+        "    vertexTexCoords = (textureMatrix * vec4(texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "#version 150\n"
+        "uniform sampler2D sourceTexture;\n"
+        "uniform bool hasTexture;\n"
+        "uniform bool distanceField;\n"
+        "in vec4 vertexColor;\n"
+        "in vec2 vertexTexCoords;\n"
+        "out vec4 fragmentColor;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    if (hasTexture && distanceField)\n"
+        "    {\n"
+        "        float distance = texture(sourceTexture, vertexTexCoords).a;\n"
+        "        float width = 0.5 * fwidth(distance);\n"
+        "        float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+        "        fragmentColor = vec4(vertexColor.rgb, vertexColor.a * alpha);\n"
+        "    }\n"
+        "    else if (hasTexture)\n"
+        "        fragmentColor = vertexColor * texture(sourceTexture, vertexTexCoords);\n"
+        "    else\n"
+        "        fragmentColor = vertexColor;\n"
+        "}\n";
+
+    // Compile a shader, returns 0 on failure
+    GLuint compileShader(GLenum type, const char* source)
+    {
+        GLuint shader = 0;
+        glCheck(shader = core.createShader(type));
+        glCheck(core.shaderSource(shader, 1, &source, NULL));
+        glCheck(core.compileShader(shader));
+
+        GLint success = 0;
+        glCheck(core.getShaderiv(shader, GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(core.getShaderInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile the core profile rendering shader:" << std::endl
+                      << log << std::endl;
+            glCheck(core.deleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+    // Initial size of the streaming buffer, in bytes
+    const std::size_t initialStreamCapacity = 64 * 1024;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CoreRenderer::CoreRenderer() :
+m_program         (0),
+m_vertexArray     (0),
+m_streamBuffer    (0),
+m_streamCapacity  (0),
+m_streamOffset    (0),
+m_indexBuffer     (0),
+m_quadCapacity    (0),
+m_projectionMatrix(-1),
+m_modelViewMatrix (-1),
+m_textureMatrix   (-1),
+m_hasTexture      (-1),
+m_distanceField   (-1),
+m_vertices        (NULL),
+m_vertexBuffer    (0),
+m_attributeBuffer (0),
+m_attributeOffset (0),
+m_bound           (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CoreRenderer::~CoreRenderer()
+{
+    // The vertex array object belongs to the context of the render target,
+    // which is usually destroyed at this point along with it. Buffers and
+    // programs are shared, so they can be released from any context.
+    TransientContextLock lock;
+
+    if (m_program)
+        glCheck(core.deleteProgram(m_program));
+
+    if (m_streamBuffer)
+        glCheck(core.deleteBuffers(1, &m_streamBuffer));
+
+    if (m_indexBuffer)
+        glCheck(core.deleteBuffers(1, &m_indexBuffer));
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::isCoreContext()
+{
+    // Discard errors left by previous calls, we rely on glGetError below
+    glGetError();
+
+    // Profiles exist since OpenGL 3.2, GL_MAJOR_VERSION is an invalid enum before 3.0
+    GLint majorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    if ((glGetError() != GL_NO_ERROR) || (majorVersion < 3))
+        return false;
+
+    GLint profileMask = 0;
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profileMask);
+    if (glGetError() != GL_NO_ERROR)
+        return false;
+
+    return (profileMask & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::create()
+{
+    if (!loadCoreFunctions())
+    {
+        err() << "Failed to load the OpenGL functions of the core profile renderer" << std::endl;
+        return false;
+    }
+
+    // Build the program
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    if (!vertexShader || !fragmentShader)
+    {
+        if (vertexShader)
+            glCheck(core.deleteShader(vertexShader));
+        if (fragmentShader)
+            glCheck(core.deleteShader(fragmentShader));
+        return false;
+    }
+
+    glCheck(m_program = core.createProgram());
+    glCheck(core.attachShader(m_program, vertexShader));
+    glCheck(core.attachShader(m_program, fragmentShader));
+    glCheck(core.bindAttribLocation(m_program, PositionAttribute, "position"));
+    glCheck(core.bindAttribLocation(m_program, ColorAttribute, "color"));
+    glCheck(core.bindAttribLocation(m_program, TexCoordsAttribute, "texCoords"));
+    glCheck(core.linkProgram(m_program));
+
+    // The shaders are flagged for deletion, they will be released along with the program
+    glCheck(core.deleteShader(vertexShader));
+    glCheck(core.deleteShader(fragmentShader));
+
+    GLint success = 0;
+    glCheck(core.getProgramiv(m_program, GL_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(core.getProgramInfoLog(m_program, sizeof(log), 0, log));
+        err() << "Failed to link the core profile rendering shader:" << std::endl
+              << log << std::endl;
+        glCheck(core.deleteProgram(m_program));
+        m_program = 0;
+        return false;
+    }
+
+    glCheck(m_projectionMatrix = core.getUniformLocation(m_program, "projectionMatrix"));
+    glCheck(m_modelViewMatrix = core.getUniformLocation(m_program, "modelViewMatrix"));
+    glCheck(m_textureMatrix = core.getUniformLocation(m_program, "textureMatrix"));
+    glCheck(m_hasTexture = core.getUniformLocation(m_program, "hasTexture"));
+    glCheck(m_distanceField = core.getUniformLocation(m_program, "distanceField"));
+
+    // Create the vertex array and the buffers
+    glCheck(core.genVertexArrays(1, &m_vertexArray));
+    glCheck(core.genBuffers(1, &m_streamBuffer));
+    glCheck(core.genBuffers(1, &m_indexBuffer));
+
+    bind();
+
+    // Texture unit 0 is the only one used
+    GLint sourceTexture = -1;
+    glCheck(sourceTexture = core.getUniformLocation(m_program, "sourceTexture"));
+    glCheck(core.uniform1i(sourceTexture, 0));
+
+    glCheck(core.enableVertexAttribArray(PositionAttribute));
+    glCheck(core.enableVertexAttribArray(ColorAttribute));
+    glCheck(core.enableVertexAttribArray(TexCoordsAttribute));
+
+    // The index buffer binding is part of the vertex array state
+    glCheck(core.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer));
+
+    m_streamCapacity = initialStreamCapacity;
+    glCheck(core.bindBuffer(GL_ARRAY_BUFFER, m_streamBuffer));
+    glCheck(core.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(m_streamCapacity), NULL, GL_STREAM_DRAW));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::bind()
+{
+    if (!m_bound)
+    {
+        glCheck(core.useProgram(m_program));
+        glCheck(core.bindVertexArray(m_vertexArray));
+        glCheck(core.activeTexture(GL_TEXTURE0));
+        m_bound = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::unbind()
+{
+    if (m_bound)
+    {
+        glCheck(core.useProgram(0));
+        glCheck(core.bindVertexArray(0));
+        glCheck(core.bindBuffer(GL_ARRAY_BUFFER, 0));
+        m_bound = false;
+
+        // The user may change the buffer bindings, the attributes must be set up again
+        m_attributeBuffer = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setProjectionMatrix(const float* matrix)
+{
+    bind();
+    glCheck(core.uniformMatrix4fv(m_projectionMatrix, 1, GL_FALSE, matrix));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setModelViewMatrix(const float* matrix)
+{
+    bind();
+    glCheck(core.uniformMatrix4fv(m_modelViewMatrix, 1, GL_FALSE, matrix));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setTexture(unsigned int texture, const float* matrix)
+{
+    bind();
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+    glCheck(core.uniform1i(m_hasTexture, texture ? 1 : 0));
+    glCheck(core.uniformMatrix4fv(m_textureMatrix, 1, GL_FALSE, matrix));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setDistanceField(bool enabled)
+{
+    bind();
+    glCheck(core.uniform1i(m_distanceField, enabled ? 1 : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setVertices(const Vertex* vertices)
+{
+    m_vertices = vertices;
+    m_vertexBuffer = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setVertexBuffer(unsigned int buffer)
+{
+    m_vertices = NULL;
+    m_vertexBuffer = buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    bind();
+
+    // Find where the vertices are in graphics memory
+    GLuint buffer = m_streamBuffer;
+    std::size_t offset = 0;
+    if (m_vertices)
+    {
+        offset = streamVertices(m_vertices + firstVertex, vertexCount);
+    }
+    else
+    {
+        buffer = m_vertexBuffer;
+        offset = firstVertex * sizeof(Vertex);
+    }
+
+    // Point the vertex attributes to them
+    if ((buffer != m_attributeBuffer) || (offset != m_attributeOffset))
+    {
+        const char* data = reinterpret_cast<const char*>(offset);
+        glCheck(core.bindBuffer(GL_ARRAY_BUFFER, buffer));
+        glCheck(core.vertexAttribPointer(PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 0));
+        glCheck(core.vertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), data + 8));
+        glCheck(core.vertexAttribPointer(TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 12));
+
+        m_attributeBuffer = buffer;
+        m_attributeOffset = offset;
+    }
+
+    if (type == Quads)
+    {
+        // Quads don't exist in the core profile, draw two indexed triangles per quad instead
+        std::size_t quadCount = vertexCount / 4;
+        ensureQuadIndices(quadCount);
+        glCheck(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(quadCount * 6), GL_UNSIGNED_INT, NULL));
+    }
+    else
+    {
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN};
+        glCheck(glDrawArrays(modes[type], 0, static_cast<GLsizei>(vertexCount)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::ensureQuadIndices(std::size_t quadCount)
+{
+    if (quadCount <= m_quadCapacity)
+        return;
+
+    // Grow geometrically to avoid rebuilding the indices too often
+    std::size_t capacity = std::max<std::size_t>(quadCount, m_quadCapacity * 2);
+
+    std::vector<GLuint> indices(capacity * 6);
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        GLuint first = static_cast<GLuint>(i * 4);
+        indices[i * 6 + 0] = first + 0;
+        indices[i * 6 + 1] = first + 1;
+        indices[i * 6 + 2] = first + 2;
+        indices[i * 6 + 3] = first + 0;
+        indices[i * 6 + 4] = first + 2;
+        indices[i * 6 + 5] = first + 3;
+    }
+
+    // The element array binding of our vertex array always refers to the index buffer
+    glCheck(core.bufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(indices.size() * sizeof(GLuint)), &indices[0], GL_STATIC_DRAW));
+
+    m_quadCapacity = capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::streamVertices(const Vertex* vertices, std::size_t vertexCount)
+{
+    std::size_t size = vertexCount * sizeof(Vertex);
+
+    glCheck(core.bindBuffer(GL_ARRAY_BUFFER, m_streamBuffer));
+
+    if (m_streamOffset + size > m_streamCapacity)
+    {
+        // Grow the buffer if the vertices don't fit in it
+        while (size > m_streamCapacity)
+            m_streamCapacity *= 2;
+
+        // Orphan the current storage: the driver keeps it alive for the pending draws
+        // and gives us a fresh one, so that we never wait for the GPU
+        glCheck(core.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(m_streamCapacity), NULL, GL_STREAM_DRAW));
+        m_streamOffset = 0;
+
+        // The attributes may point to the same offset of the new storage, force an update
+        m_attributeBuffer = 0;
+    }
+
+    std::size_t offset = m_streamOffset;
+    glCheck(core.bufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptrARB>(offset), static_cast<GLsizeiptrARB>(size), vertices));
+    m_streamOffset += size;
+
+    return offset;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// OpenGL ES has no core profile, the renderer is never used
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CoreRenderer::CoreRenderer() :
+m_program         (0),
+m_vertexArray     (0),
+m_streamBuffer    (0),
+m_streamCapacity  (0),
+m_streamOffset    (0),
+m_indexBuffer     (0),
+m_quadCapacity    (0),
+m_projectionMatrix(-1),
+m_modelViewMatrix (-1),
+m_textureMatrix   (-1),
+m_hasTexture      (-1),
+m_distanceField   (-1),
+m_vertices        (NULL),
+m_vertexBuffer    (0),
+m_attributeBuffer (0),
+m_attributeOffset (0),
+m_bound           (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CoreRenderer::~CoreRenderer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::isCoreContext()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::create()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::bind()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::unbind()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setProjectionMatrix(const float*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setModelViewMatrix(const float*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setTexture(unsigned int, const float*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setDistanceField(bool)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setVertices(const Vertex*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setVertexBuffer(unsigned int)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::drawPrimitives(PrimitiveType, std::size_t, std::size_t)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::ensureQuadIndices(std::size_t)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::streamVertices(const Vertex*, std::size_t)
+{
+    return 0;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
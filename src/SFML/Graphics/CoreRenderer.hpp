@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CORERENDERER_HPP
+#define SFML_CORERENDERER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Vertex;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Rendering backend of sf::RenderTarget for OpenGL
+///        core profile contexts
+///
+/// The fixed-function pipeline (matrix stacks, client-side
+/// vertex arrays, GL_QUADS, attribute stacks) doesn't exist in
+/// core profile contexts. This backend replaces it with a
+/// built-in GLSL program, a vertex array object and a streaming
+/// vertex buffer. Matrices are passed as uniforms, and quads
+/// are drawn as indexed triangles.
+///
+/// An instance is bound to the context in which it was created.
+///
+////////////////////////////////////////////////////////////
+class CoreRenderer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CoreRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CoreRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context is a core profile context
+    ///
+    /// \return True if the active context uses the core profile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCoreContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the OpenGL objects of the renderer
+    ///
+    /// The context in which the renderer will be used must be
+    /// active.
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the program and vertex array of the renderer
+    ///
+    ////////////////////////////////////////////////////////////
+    void bind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the program and vertex array of the renderer
+    ///
+    /// This leaves the context clean for user OpenGL code.
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the projection matrix
+    ///
+    /// \param matrix 4x4 matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProjectionMatrix(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the model-view matrix
+    ///
+    /// \param matrix 4x4 matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void setModelViewMatrix(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture to sample
+    ///
+    /// \param texture OpenGL identifier of the texture, or 0 to disable texturing
+    /// \param matrix  4x4 texture coordinates matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(unsigned int texture, const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the distance field mode
+    ///
+    /// In this mode, the alpha channel of the texture is read as
+    /// a signed distance to the outline of a shape, and turned
+    /// into coverage; this replaces the shader of sf::Font for
+    /// distance field glyphs, which needs the compatibility profile.
+    ///
+    /// \param enabled True to render the texture as a distance field
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceField(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source the next draws from vertices in system memory
+    ///
+    /// The vertices are streamed to graphics memory by drawPrimitives.
+    ///
+    /// \param vertices Pointer to the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertices(const Vertex* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source the next draws from a vertex buffer
+    ///
+    /// \param buffer OpenGL identifier of the buffer, which contains sf::Vertex elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexBuffer(unsigned int buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the current vertex source
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to draw
+    /// \param vertexCount Number of vertices to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that the index buffer can draw a number of quads
+    ///
+    /// \param quadCount Number of quads to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureQuadIndices(std::size_t quadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy vertices to the streaming buffer
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices to copy
+    ///
+    /// \return Offset of the copied vertices in the streaming buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t streamVertices(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int  m_program;           ///< Built-in GLSL program
+    unsigned int  m_vertexArray;       ///< Vertex array object holding the attribute layout
+    unsigned int  m_streamBuffer;      ///< Vertex buffer receiving the vertices from system memory
+    std::size_t   m_streamCapacity;    ///< Size of the streaming buffer, in bytes
+    std::size_t   m_streamOffset;      ///< Position of the next write in the streaming buffer, in bytes
+    unsigned int  m_indexBuffer;       ///< Index buffer converting quads to triangles
+    std::size_t   m_quadCapacity;      ///< Number of quads that the index buffer can draw
+    int           m_projectionMatrix;  ///< Location of the projection matrix uniform
+    int           m_modelViewMatrix;   ///< Location of the model-view matrix uniform
+    int           m_textureMatrix;     ///< Location of the texture matrix uniform
+    int           m_hasTexture;        ///< Location of the texturing switch uniform
+    int           m_distanceField;     ///< Location of the distance field switch uniform
+    const Vertex* m_vertices;          ///< Vertices of the next draw, if sourced from system memory
+    unsigned int  m_vertexBuffer;      ///< Vertex buffer of the next draw, if sourced from graphics memory
+    unsigned int  m_attributeBuffer;   ///< Buffer that the vertex attributes currently point to
+    std::size_t   m_attributeOffset;   ///< Offset of the vertex attributes in that buffer, in bytes
+    bool          m_bound;             ///< Are the program and vertex array bound?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CORERENDERER_HPP
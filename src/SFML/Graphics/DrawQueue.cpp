@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+    // All the existing queues, so that fonts can tell whether recorded draws use their textures
+    sf::Mutex queuesMutex;
+    std::vector<const sf::DrawQueue*> queues;
+
+    // Strict weak ordering of blend modes, so that draws using the same mode end up next to each other
+    bool blendModeLess(const sf::BlendMode& left, const sf::BlendMode& right)
+    {
+        if (left.colorSrcFactor != right.colorSrcFactor) return left.colorSrcFactor < right.colorSrcFactor;
+        if (left.colorDstFactor != right.colorDstFactor) return left.colorDstFactor < right.colorDstFactor;
+        if (left.colorEquation  != right.colorEquation)  return left.colorEquation  < right.colorEquation;
+        if (left.alphaSrcFactor != right.alphaSrcFactor) return left.alphaSrcFactor < right.alphaSrcFactor;
+        if (left.alphaDstFactor != right.alphaDstFactor) return left.alphaDstFactor < right.alphaDstFactor;
+        return left.alphaEquation < right.alphaEquation;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Render target which records the primitives drawn
+///        to it into a draw queue instead of rendering them
+///
+////////////////////////////////////////////////////////////
+class DrawQueueRecorder : public RenderTarget
+{
+public:
+
+    virtual Vector2u getSize() const
+    {
+        return Vector2u(0, 0);
+    }
+
+    virtual bool setActive(bool)
+    {
+        // There's no OpenGL context behind a recorder
+        return false;
+    }
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::Statistics::Statistics() :
+draws                 (0),
+stateChanges          (0),
+stateChangesEliminated(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::DrawQueue() :
+m_commands  (),
+m_vertices  (),
+m_layer     (0),
+m_recorder  (NULL),
+m_statistics()
+{
+    Lock lock(queuesMutex);
+    queues.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::~DrawQueue()
+{
+    {
+        Lock lock(queuesMutex);
+        queues.erase(std::remove(queues.begin(), queues.end(), this), queues.end());
+    }
+
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::add(const Drawable& drawable, int layer, const RenderStates& states)
+{
+    // Create the recorder on first use
+    if (!m_recorder)
+    {
+        m_recorder = new priv::DrawQueueRecorder;
+        static_cast<RenderTarget*>(m_recorder)->m_queue = this;
+    }
+
+    // The drawable sends its primitives to the recorder, which forwards them to record()
+    m_layer = layer;
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                    int layer, const RenderStates& states)
+{
+    // Nothing to record?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    m_layer = layer;
+    record(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::clear()
+{
+    m_commands.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawQueue::getDrawCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::submit(RenderTarget& target)
+{
+    // Group the draws by layer then render states; the sort is stable so that
+    // draws sharing the same states keep their recording order
+    std::size_t recordedChanges = countStateChanges(m_commands);
+    std::stable_sort(m_commands.begin(), m_commands.end(), CommandLess());
+    std::size_t sortedChanges = countStateChanges(m_commands);
+
+    m_statistics.draws = m_commands.size();
+    m_statistics.stateChanges = sortedChanges;
+    m_statistics.stateChangesEliminated = (recordedChanges > sortedChanges) ? recordedChanges - sortedChanges : 0;
+
+    for (std::vector<Command>::const_iterator it = m_commands.begin(); it != m_commands.end(); ++it)
+    {
+        if (it->vertexBuffer)
+            target.draw(*it->vertexBuffer, it->firstVertex, it->vertexCount, it->states);
+        else
+            target.draw(&m_vertices[it->firstVertex], it->vertexCount, it->type, it->states);
+    }
+
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const DrawQueue::Statistics& DrawQueue::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawQueue::isRecorded(const Texture& texture)
+{
+    Lock lock(queuesMutex);
+
+    for (std::vector<const DrawQueue*>::const_iterator queue = queues.begin(); queue != queues.end(); ++queue)
+    {
+        const std::vector<Command>& commands = (*queue)->m_commands;
+        for (std::vector<Command>::const_iterator it = commands.begin(); it != commands.end(); ++it)
+        {
+            if (it->states.texture == &texture)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    Command command;
+    command.layer        = m_layer;
+    command.states       = states;
+    command.type         = type;
+    command.vertexBuffer = NULL;
+    command.firstVertex  = m_vertices.size();
+    command.vertexCount  = vertexCount;
+    m_commands.push_back(command);
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::record(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states)
+{
+    Command command;
+    command.layer        = m_layer;
+    command.states       = states;
+    command.type         = vertexBuffer.getPrimitiveType();
+    command.vertexBuffer = &vertexBuffer;
+    command.firstVertex  = firstVertex;
+    command.vertexCount  = vertexCount;
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawQueue::CommandLess::operator ()(const Command& left, const Command& right) const
+{
+    if (left.layer != right.layer)
+        return left.layer < right.layer;
+
+    // Shader changes are the most expensive, then texture changes
+    if (left.states.shader != right.states.shader)
+        return std::less<const Shader*>()(left.states.shader, right.states.shader);
+
+    if (left.states.texture != right.states.texture)
+        return std::less<const Texture*>()(left.states.texture, right.states.texture);
+
+    return blendModeLess(left.states.blendMode, right.states.blendMode);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawQueue::countStateChanges(const std::vector<Command>& commands)
+{
+    std::size_t changes = 0;
+
+    for (std::size_t i = 1; i < commands.size(); ++i)
+    {
+        const RenderStates& previous = commands[i - 1].states;
+        const RenderStates& current = commands[i].states;
+
+        if (current.shader != previous.shader)
+            changes++;
+        if (current.texture != previous.texture)
+            changes++;
+        if (current.blendMode != previous.blendMode)
+            changes++;
+    }
+
+    return changes;
+}
+
+} // namespace sf
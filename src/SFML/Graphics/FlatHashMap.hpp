@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FLATHASHMAP_HPP
+#define SFML_FLATHASHMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compute the hash of a 64-bit key
+///
+/// \param key Key to hash
+///
+/// \return Hash of the key, with all the bits of the key mixed
+///
+////////////////////////////////////////////////////////////
+inline std::size_t hashValue(Uint64 key)
+{
+    // Finalizer of MurmurHash3
+    key ^= key >> 33;
+    key *= (static_cast<Uint64>(0xff51afd7) << 32) | 0xed558ccd;
+    key ^= key >> 33;
+    key *= (static_cast<Uint64>(0xc4ceb9fe) << 32) | 0x1a85ec53;
+    key ^= key >> 33;
+
+    return static_cast<std::size_t>(key);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the hash of a pair of keys
+///
+/// \param key Key to hash
+///
+/// \return Hash of the key
+///
+////////////////////////////////////////////////////////////
+inline std::size_t hashValue(const std::pair<unsigned int, Uint64>& key)
+{
+    return hashValue(key.second ^ (static_cast<Uint64>(key.first) * 0x9e3779b9));
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Hash table with open addressing
+///
+/// The entries are stored directly in a single array, and
+/// collisions are resolved by linear probing, which is much
+/// more cache friendly than the nodes of std::map. Erasing
+/// shifts the following entries back, so that no tombstone
+/// is left behind. Pointers to the values are invalidated by
+/// insert and erase.
+///
+/// The key type must be copyable, comparable with == and
+/// have a hashValue overload.
+///
+////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+class FlatHashMap
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FlatHashMap() :
+    m_slots(),
+    m_count(0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look for a key
+    ///
+    /// \param key Key to look for
+    ///
+    /// \return Pointer to the value of the key, or NULL if it's not in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    Value* find(const Key& key)
+    {
+        if (m_slots.empty())
+            return NULL;
+
+        std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = hashValue(key) & mask; m_slots[i].used; i = (i + 1) & mask)
+        {
+            if (m_slots[i].key == key)
+                return &m_slots[i].value;
+        }
+
+        return NULL;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a key, or replace its value if it's already in the table
+    ///
+    /// \param key   Key to insert
+    /// \param value Value of the key
+    ///
+    /// \return Reference to the stored value
+    ///
+    ////////////////////////////////////////////////////////////
+    Value& insert(const Key& key, const Value& value)
+    {
+        // Keep the table at most half full, so that probing sequences stay short
+        if ((m_count + 1) * 2 > m_slots.size())
+            rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t i = hashValue(key) & mask;
+        while (m_slots[i].used && !(m_slots[i].key == key))
+            i = (i + 1) & mask;
+
+        if (!m_slots[i].used)
+        {
+            m_slots[i].used = true;
+            m_slots[i].key = key;
+            ++m_count;
+        }
+
+        m_slots[i].value = value;
+
+        return m_slots[i].value;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a key from the table
+    ///
+    /// \param key Key to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void erase(const Key& key)
+    {
+        if (m_slots.empty())
+            return;
+
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t i = hashValue(key) & mask;
+        while (m_slots[i].used && !(m_slots[i].key == key))
+            i = (i + 1) & mask;
+
+        if (!m_slots[i].used)
+            return;
+
+        m_slots[i].used = false;
+        --m_count;
+
+        // Move back the following entries of the probing sequence which
+        // can't be reached anymore because of the hole
+        for (std::size_t j = (i + 1) & mask; m_slots[j].used; j = (j + 1) & mask)
+        {
+            std::size_t home = hashValue(m_slots[j].key) & mask;
+            bool reachable = (i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j));
+            if (!reachable)
+            {
+                m_slots[i] = m_slots[j];
+                m_slots[j].used = false;
+                i = j;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the keys
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear()
+    {
+        m_slots.clear();
+        m_count = 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of keys in the table
+    ///
+    /// \return Number of keys
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const
+    {
+        return m_count;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Slot() : key(), value(), used(false) {}
+
+        Key   key;   ///< Key of the entry
+        Value value; ///< Value of the entry
+        bool  used;  ///< Does the slot contain an entry?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of slots, and insert the entries again
+    ///
+    /// \param capacity New number of slots (must be a power of two)
+    ///
+    ////////////////////////////////////////////////////////////
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        m_slots.swap(slots);
+        m_count = 0;
+
+        for (typename std::vector<Slot>::const_iterator it = slots.begin(); it != slots.end(); ++it)
+        {
+            if (it->used)
+                insert(it->key, it->value);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Slot> m_slots; ///< Slots of the table (the size is a power of two)
+    std::size_t       m_count; ///< Number of used slots
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FLATHASHMAP_HPP
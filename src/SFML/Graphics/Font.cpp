@@ -26,11 +26,21 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/FlatHashMap.hpp>
+#include <SFML/Graphics/GlyphAtlas.hpp>
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/Graphics/GlyphTicket.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Err.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -38,8 +48,11 @@
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 
 
 namespace
@@ -61,6 +74,84 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Character size at which distance field glyphs are rasterized,
+    // and width of the margin where the distance is stored
+    const unsigned int distanceFieldSize   = 64;
+    const int          distanceFieldSpread = 8;
+
+    // Fragment shader turning the distance stored in the alpha channel into coverage
+    const char* distanceFieldShader =
+        "uniform sampler2D texture;"
+        "void main()"
+        "{"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;"
+        "    float width = 0.5 * fwidth(distance);"
+        "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);"
+        "}";
+
+    // Distance field shaders of all the fonts, recognized by the core profile renderer
+    sf::Mutex distanceFieldShadersMutex;
+    std::vector<const sf::Shader*> distanceFieldShaders;
+
+    // Build the key of a glyph by combining the code point, bold flag, and outline thickness
+    sf::Uint64 glyphKey(sf::Uint32 codePoint, bool bold, float outlineThickness)
+    {
+        return (static_cast<sf::Uint64>(*reinterpret_cast<sf::Uint32*>(&outlineThickness)) << 32)
+             | (static_cast<sf::Uint64>(bold ? 1 : 0) << 31)
+             |  static_cast<sf::Uint64>(codePoint);
+    }
+
+    // Identifier and version of the glyph cache files
+    const char       glyphCacheMagic[4] = {'S', 'F', 'G', 'C'};
+    const sf::Uint32 glyphCacheVersion  = 1;
+
+    // Serialization of the glyph cache, in little endian
+    void writeUint32(std::vector<char>& buffer, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+    void writeFloat(std::vector<char>& buffer, float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUint32(buffer, bits);
+    }
+    void writeString(std::vector<char>& buffer, const char* value)
+    {
+        std::size_t length = value ? std::strlen(value) : 0;
+        writeUint32(buffer, static_cast<sf::Uint32>(length));
+        buffer.insert(buffer.end(), value, value + length);
+    }
+    bool readUint32(sf::InputStream& stream, sf::Uint32& value)
+    {
+        unsigned char bytes[4];
+        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
+            return false;
+
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+        return true;
+    }
+    bool readFloat(sf::InputStream& stream, float& value)
+    {
+        sf::Uint32 bits;
+        if (!readUint32(stream, bits))
+            return false;
+
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+    bool readString(sf::InputStream& stream, std::string& value)
+    {
+        sf::Uint32 length;
+        if (!readUint32(stream, length) || (length > 1024))
+            return false;
+
+        value.resize(length);
+        return (length == 0) || (stream.read(&value[0], length) == length);
+    }
 }
 
 
@@ -68,12 +159,25 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_info     ()
+m_library    (NULL),
+m_face       (NULL),
+m_streamRec  (NULL),
+m_stroker    (NULL),
+m_refCount   (NULL),
+m_info       (),
+m_sharedAtlas(false),
+m_atlasLimit (0),
+m_budget     (0),
+m_atlasClock (0),
+m_cacheHits  (0),
+m_cacheMisses(0),
+m_releases   (0),
+m_evictions  (0),
+m_sdfEnabled (false),
+m_sdfShader  (NULL),
+m_kerning    (NULL),
+m_fileName   (),
+m_tickets    ()
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -89,8 +193,21 @@ m_streamRec  (copy.m_streamRec),
 m_stroker    (copy.m_stroker),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_atlases    (),
+m_pixelBuffer(copy.m_pixelBuffer),
+m_sharedAtlas(copy.m_sharedAtlas),
+m_atlasLimit (copy.m_atlasLimit),
+m_budget     (copy.m_budget),
+m_atlasClock (copy.m_atlasClock),
+m_cacheHits  (0),
+m_cacheMisses(0),
+m_releases   (0),
+m_evictions  (0),
+m_sdfEnabled (copy.m_sdfEnabled),
+m_sdfShader  (NULL),
+m_kerning    (NULL),
+m_fileName   (copy.m_fileName),
+m_tickets    ()
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -101,6 +218,10 @@ m_pixelBuffer(copy.m_pixelBuffer)
 
     if (m_refCount)
         (*m_refCount)++;
+
+    // The glyph atlases, on the other hand, are duplicated
+    for (AtlasTable::const_iterator it = copy.m_atlases.begin(); it != copy.m_atlases.end(); ++it)
+        m_atlases[it->first] = new priv::GlyphAtlas(*it->second);
 }
 
 
@@ -109,6 +230,14 @@ Font::~Font()
 {
     cleanup();
 
+    if (m_sdfShader)
+    {
+        Lock lock(distanceFieldShadersMutex);
+        distanceFieldShaders.erase(std::remove(distanceFieldShaders.begin(), distanceFieldShaders.end(), m_sdfShader), distanceFieldShaders.end());
+    }
+
+    delete m_sdfShader;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -165,6 +294,7 @@ bool Font::loadFromFile(const std::string& filename)
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_fileName = filename;
 
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
@@ -321,26 +451,31 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    // Get the atlas corresponding to the character size
+    priv::GlyphAtlas& atlas = getAtlas(characterSize);
+
+    // Distance field glyphs are shared by all the character sizes
+    if (m_sdfEnabled)
+        return getDistanceFieldGlyph(atlas, codePoint, characterSize, bold, outlineThickness);
 
     // Build the key by combining the code point, bold flag, and outline thickness
-    Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
-               | (static_cast<Uint64>(bold ? 1 : 0) << 31)
-               |  static_cast<Uint64>(codePoint);
+    Uint64 key = glyphKey(codePoint, bold, outlineThickness);
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    priv::GlyphAtlas::Key atlasKey(characterSize, key);
+    const Glyph* found = atlas.find(atlasKey);
+    if (found)
     {
         // Found: just return it
-        return it->second;
+        m_cacheHits++;
+        return *found;
     }
     else
     {
         // Not found: we have to load it
+        m_cacheMisses++;
         Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        return atlas.insert(atlasKey, glyph);
     }
 }
 
@@ -354,7 +489,23 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    // Look for the pair in the cache first, which saves the conversion of the characters
+    // and the switch of size; the key holds 21 bits per code point and 22 bits of size
+    bool cacheable = (first < (1 << 21)) && (second < (1 << 21)) && (characterSize < (1 << 22));
+    Uint64 key = (static_cast<Uint64>(characterSize) << 42) | (static_cast<Uint64>(first) << 21) | second;
+    if (cacheable && m_kerning)
+    {
+        const float* cached = m_kerning->find(key);
+        if (cached)
+            return *cached;
+    }
+
+    float result = 0.f;
+    if (setCurrentSize(characterSize))
     {
         // Convert the characters to indices
         FT_UInt index1 = FT_Get_Char_Index(face, first);
@@ -366,16 +517,20 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
         // X advance is already in pixels for bitmap fonts
         if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
-
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+            result = static_cast<float>(kerning.x);
+        else
+            result = static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
     }
-    else
+
+    if (cacheable)
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        if (!m_kerning)
+            m_kerning = new KerningTable;
+
+        m_kerning->insert(key, result);
     }
+
+    return result;
 }
 
 
@@ -438,7 +593,489 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return getAtlas(characterSize).getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setSharedAtlasEnabled(bool enabled)
+{
+    if (enabled != m_sharedAtlas)
+    {
+        // The glyphs already loaded are in the wrong textures
+        clearAtlases();
+        m_sharedAtlas = enabled;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isSharedAtlasEnabled() const
+{
+    return m_sharedAtlas;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAtlasMemoryLimit(std::size_t bytes)
+{
+    m_atlasLimit = bytes;
+
+    std::size_t limit = getEffectiveAtlasLimit();
+    for (AtlasTable::iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+        it->second->setMemoryLimit(limit);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getAtlasMemoryLimit() const
+{
+    return m_atlasLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setMemoryBudget(std::size_t bytes)
+{
+    m_budget = bytes;
+
+    // No single atlas may exceed the budget
+    std::size_t limit = getEffectiveAtlasLimit();
+    for (AtlasTable::iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+        it->second->setMemoryLimit(limit);
+
+    applyMemoryBudget(NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getMemoryBudget() const
+{
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::CacheStats Font::getCacheStats() const
+{
+    CacheStats stats;
+    stats.glyphCount       = 0;
+    stats.textureCount     = m_atlases.size();
+    stats.textureBytes     = 0;
+    stats.hits             = m_cacheHits;
+    stats.misses           = m_cacheMisses;
+    stats.evictedGlyphs    = m_evictions;
+    stats.releasedTextures = m_releases;
+
+    for (AtlasTable::const_iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+    {
+        stats.glyphCount    += it->second->getGlyphCount();
+        stats.textureBytes  += it->second->getMemoryUsage();
+        stats.evictedGlyphs += it->second->getEvictionCount();
+    }
+
+    return stats;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled && !Shader::isAvailable())
+    {
+        err() << "Failed to enable distance field glyphs: your system doesn't support shaders" << std::endl;
+        return false;
+    }
+
+    if (enabled != m_sdfEnabled)
+    {
+        // The glyphs already loaded have the wrong format
+        clearAtlases();
+        m_sdfEnabled = enabled;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldEnabled() const
+{
+    return m_sdfEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* Font::getDistanceFieldShader() const
+{
+    if (!m_sdfShader && Shader::isAvailable())
+    {
+        m_sdfShader = new Shader;
+        if (m_sdfShader->loadFromMemory(distanceFieldShader, Shader::Fragment))
+        {
+            m_sdfShader->setUniform("texture", Shader::CurrentTexture);
+
+            Lock lock(distanceFieldShadersMutex);
+            distanceFieldShaders.push_back(m_sdfShader);
+        }
+        else
+        {
+            delete m_sdfShader;
+            m_sdfShader = NULL;
+        }
+    }
+
+    return m_sdfShader;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldShader(const Shader* shader)
+{
+    Lock lock(distanceFieldShadersMutex);
+
+    return std::find(distanceFieldShaders.begin(), distanceFieldShaders.end(), shader) != distanceFieldShaders.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preload(const String& characters, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    if (!m_face)
+        return;
+
+    // Distance field glyphs are rasterized at the reference size
+    unsigned int rasterSize = characterSize;
+    float rasterThickness = outlineThickness;
+    unsigned int margin = 0;
+    if (m_sdfEnabled)
+    {
+        float scale = static_cast<float>(characterSize) / distanceFieldSize;
+        rasterSize = distanceFieldSize;
+        rasterThickness = (scale > 0) ? outlineThickness / scale : outlineThickness;
+        margin = distanceFieldSpread;
+    }
+
+    // Count the glyphs which are not loaded yet
+    priv::GlyphAtlas& atlas = getAtlas(characterSize);
+    Uint64 missing = 0;
+    for (std::size_t i = 0; i < characters.getSize(); ++i)
+    {
+        if (!atlas.find(priv::GlyphAtlas::Key(rasterSize, glyphKey(characters[i], bold, rasterThickness))))
+            ++missing;
+    }
+
+    // Make room for all of them at once, so that the texture grows only once
+    // (a glyph covers about three quarters of its padded square)
+    Uint64 side = rasterSize + 2 * (margin + 1) + static_cast<Uint64>(std::ceil(std::fabs(rasterThickness) * 2));
+    atlas.reserve(missing * side * side * 3 / 4);
+
+    for (std::size_t i = 0; i < characters.getSize(); ++i)
+        getGlyph(characters[i], characterSize, bold, outlineThickness);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::requestGlyphs(GlyphTicket& ticket, const String& characters, unsigned int characterSize, bool bold, float outlineThickness, unsigned int threadCount) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+    {
+        err() << "Failed to request glyphs (no font loaded)" << std::endl;
+        return false;
+    }
+
+    if (ticket.isPending())
+    {
+        err() << "Failed to request glyphs (the ticket already has a pending request)" << std::endl;
+        return false;
+    }
+
+    // Distance field glyphs are rasterized at the reference size
+    unsigned int rasterSize = characterSize;
+    float rasterThickness = outlineThickness;
+    int spread = 0;
+    if (m_sdfEnabled)
+    {
+        float scale = static_cast<float>(characterSize) / distanceFieldSize;
+        rasterSize = distanceFieldSize;
+        rasterThickness = (scale > 0) ? outlineThickness / scale : outlineThickness;
+        spread = distanceFieldSpread;
+    }
+
+    // The workers open their own face: share the font data when it's
+    // in memory (or mapped by FreeType), otherwise open the file again
+    priv::GlyphRasterizer* rasterizer;
+    if (face->stream->base)
+        rasterizer = new priv::GlyphRasterizer(std::string(), face->stream->base, face->stream->size, rasterSize, spread);
+    else
+        rasterizer = new priv::GlyphRasterizer(m_fileName, NULL, 0, rasterSize, spread);
+
+    // Fonts read from a stream are copied, as the stream can't be shared
+    if (!face->stream->base && m_fileName.empty() && m_streamRec)
+    {
+        InputStream* stream = static_cast<InputStream*>(static_cast<FT_StreamRec*>(m_streamRec)->descriptor.pointer);
+        std::vector<char> data(static_cast<std::size_t>(std::max(stream->getSize(), Int64(0))));
+        if (data.empty() || (stream->seek(0) != 0) || (stream->read(&data[0], data.size()) != static_cast<Int64>(data.size())))
+        {
+            err() << "Failed to request glyphs (failed to read the font stream)" << std::endl;
+            delete rasterizer;
+            return false;
+        }
+        rasterizer->adoptData(data);
+    }
+
+    // Collect the glyphs which are not loaded yet, once each
+    std::vector<Uint32> codePoints(characters.begin(), characters.end());
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+    priv::GlyphAtlas& atlas = getAtlas(characterSize);
+    for (std::vector<Uint32>::const_iterator it = codePoints.begin(); it != codePoints.end(); ++it)
+    {
+        if (!atlas.find(priv::GlyphAtlas::Key(rasterSize, glyphKey(*it, bold, rasterThickness))))
+            rasterizer->add(*it, bold, rasterThickness);
+    }
+
+    // Start the workers, and track them with the ticket
+    if (!rasterizer->getJobs().empty())
+        rasterizer->launch(threadCount);
+
+    ticket.m_font = this;
+    ticket.m_rasterizer = rasterizer;
+    m_tickets.push_back(&ticket);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::saveGlyphCacheToFile(const std::string& filename) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+    {
+        err() << "Failed to save glyph cache to file \"" << filename << "\" (no font loaded)" << std::endl;
+        return false;
+    }
+
+    // Identify the font, so that the cache is not applied to another one
+    std::vector<char> buffer(glyphCacheMagic, glyphCacheMagic + sizeof(glyphCacheMagic));
+    writeUint32(buffer, glyphCacheVersion);
+    writeString(buffer, face->family_name);
+    writeString(buffer, face->style_name);
+    writeUint32(buffer, static_cast<Uint32>(face->num_glyphs));
+    writeUint32(buffer, m_sharedAtlas ? 1 : 0);
+    writeUint32(buffer, m_sdfEnabled ? 1 : 0);
+
+    writeUint32(buffer, static_cast<Uint32>(m_atlases.size()));
+    for (AtlasTable::const_iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+    {
+        // Only the alpha channel is stored, the glyphs are always white
+        Image image = it->second->getTexture().copyToImage();
+        writeUint32(buffer, it->first);
+        writeUint32(buffer, image.getSize().x);
+        writeUint32(buffer, image.getSize().y);
+
+        const Uint8* pixels = image.getPixelsPtr();
+        std::size_t count = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+        for (std::size_t i = 0; i < count; ++i)
+            buffer.push_back(static_cast<char>(pixels[i * 4 + 3]));
+
+        std::vector<priv::GlyphAtlas::Entry> glyphs;
+        it->second->getGlyphs(glyphs);
+        writeUint32(buffer, static_cast<Uint32>(glyphs.size()));
+        for (std::vector<priv::GlyphAtlas::Entry>::const_iterator glyph = glyphs.begin(); glyph != glyphs.end(); ++glyph)
+        {
+            const Glyph& metrics = glyph->glyph;
+            writeUint32(buffer, glyph->key.first);
+            writeUint32(buffer, static_cast<Uint32>(glyph->key.second & 0xFFFFFFFF));
+            writeUint32(buffer, static_cast<Uint32>(glyph->key.second >> 32));
+            writeUint32(buffer, glyph->alias ? 1 : 0);
+            writeFloat(buffer, metrics.advance);
+            writeFloat(buffer, metrics.bounds.left);
+            writeFloat(buffer, metrics.bounds.top);
+            writeFloat(buffer, metrics.bounds.width);
+            writeFloat(buffer, metrics.bounds.height);
+            writeUint32(buffer, static_cast<Uint32>(metrics.textureRect.left));
+            writeUint32(buffer, static_cast<Uint32>(metrics.textureRect.top));
+            writeUint32(buffer, static_cast<Uint32>(metrics.textureRect.width));
+            writeUint32(buffer, static_cast<Uint32>(metrics.textureRect.height));
+        }
+    }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file || !file.write(&buffer[0], buffer.size()))
+    {
+        err() << "Failed to save glyph cache to file \"" << filename << "\" (failed to write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCacheFromFile(const std::string& filename)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load glyph cache from file \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    return loadGlyphCacheFromStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCacheFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    MemoryInputStream stream;
+    stream.open(data, sizeInBytes);
+
+    return loadGlyphCacheFromStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCacheFromStream(InputStream& stream)
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+    {
+        err() << "Failed to load glyph cache (no font loaded)" << std::endl;
+        return false;
+    }
+
+    // Make sure that the stream's reading position is at the beginning
+    stream.seek(0);
+
+    // Check that the cache belongs to this font
+    char magic[sizeof(glyphCacheMagic)];
+    Uint32 version;
+    if ((stream.read(magic, sizeof(magic)) != sizeof(magic)) || (std::memcmp(magic, glyphCacheMagic, sizeof(magic)) != 0) ||
+        !readUint32(stream, version) || (version != glyphCacheVersion))
+    {
+        err() << "Failed to load glyph cache (not a glyph cache, or unsupported version)" << std::endl;
+        return false;
+    }
+
+    std::string family;
+    std::string style;
+    Uint32 glyphCount;
+    Uint32 shared;
+    Uint32 distanceField;
+    Uint32 atlasCount;
+    if (!readString(stream, family) || !readString(stream, style) || !readUint32(stream, glyphCount) ||
+        !readUint32(stream, shared) || !readUint32(stream, distanceField) || !readUint32(stream, atlasCount))
+    {
+        err() << "Failed to load glyph cache (truncated file)" << std::endl;
+        return false;
+    }
+
+    if ((family != (face->family_name ? face->family_name : "")) ||
+        (style != (face->style_name ? face->style_name : "")) ||
+        (glyphCount != static_cast<Uint32>(face->num_glyphs)))
+    {
+        err() << "Failed to load glyph cache (it was created from another font)" << std::endl;
+        return false;
+    }
+
+    // Read all the atlases before replacing the current ones
+    std::vector<unsigned int> sizes;
+    std::vector<Image> images;
+    std::vector<std::vector<priv::GlyphAtlas::Entry> > tables;
+    for (Uint32 i = 0; i < atlasCount; ++i)
+    {
+        Uint32 characterSize;
+        Uint32 width;
+        Uint32 height;
+        if (!readUint32(stream, characterSize) || !readUint32(stream, width) || !readUint32(stream, height) ||
+            (static_cast<Int64>(width) * height > stream.getSize() - stream.tell()))
+        {
+            err() << "Failed to load glyph cache (truncated file)" << std::endl;
+            return false;
+        }
+
+        std::vector<Uint8> pixels(static_cast<std::size_t>(width) * height * 4, 255);
+        std::vector<Uint8> alpha(static_cast<std::size_t>(width) * height);
+        if (!alpha.empty() && (stream.read(&alpha[0], alpha.size()) != static_cast<Int64>(alpha.size())))
+        {
+            err() << "Failed to load glyph cache (truncated file)" << std::endl;
+            return false;
+        }
+        for (std::size_t j = 0; j < alpha.size(); ++j)
+            pixels[j * 4 + 3] = alpha[j];
+
+        sizes.push_back(characterSize);
+        images.push_back(Image());
+        images.back().create(width, height, pixels.empty() ? NULL : &pixels[0]);
+        tables.push_back(std::vector<priv::GlyphAtlas::Entry>());
+
+        Uint32 count;
+        if (!readUint32(stream, count))
+        {
+            err() << "Failed to load glyph cache (truncated file)" << std::endl;
+            return false;
+        }
+
+        for (Uint32 j = 0; j < count; ++j)
+        {
+            Uint32 size;
+            Uint32 low;
+            Uint32 high;
+            Uint32 alias;
+            Uint32 rect[4];
+            priv::GlyphAtlas::Entry entry;
+            if (!readUint32(stream, size) || !readUint32(stream, low) || !readUint32(stream, high) || !readUint32(stream, alias) ||
+                !readFloat(stream, entry.glyph.advance) ||
+                !readFloat(stream, entry.glyph.bounds.left) || !readFloat(stream, entry.glyph.bounds.top) ||
+                !readFloat(stream, entry.glyph.bounds.width) || !readFloat(stream, entry.glyph.bounds.height) ||
+                !readUint32(stream, rect[0]) || !readUint32(stream, rect[1]) || !readUint32(stream, rect[2]) || !readUint32(stream, rect[3]))
+            {
+                err() << "Failed to load glyph cache (truncated file)" << std::endl;
+                return false;
+            }
+
+            entry.key = priv::GlyphAtlas::Key(size, (static_cast<Uint64>(high) << 32) | low);
+            entry.glyph.textureRect = IntRect(static_cast<int>(rect[0]), static_cast<int>(rect[1]), static_cast<int>(rect[2]), static_cast<int>(rect[3]));
+            entry.lastUse = 0;
+            entry.alias = (alias != 0);
+
+            if (!entry.alias && !priv::GlyphAtlas::isValidRect(entry.glyph.textureRect, Vector2u(width, height)))
+            {
+                err() << "Failed to load glyph cache (glyph rectangle outside of its texture)" << std::endl;
+                return false;
+            }
+
+            tables.back().push_back(entry);
+        }
+    }
+
+    // Replace the glyphs and settings by the ones of the cache
+    clearAtlases();
+    m_sharedAtlas = (shared != 0);
+    m_sdfEnabled = (distanceField != 0);
+
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        priv::GlyphAtlas* atlas = new priv::GlyphAtlas;
+        atlas->setMemoryLimit(getEffectiveAtlasLimit());
+        m_atlases[sizes[i]] = atlas;
+
+        if (!atlas->restore(images[i], tables[i]))
+        {
+            err() << "Failed to load glyph cache (failed to create the texture)" << std::endl;
+            clearAtlases();
+            return false;
+        }
+    }
+
+    applyMemoryBudget(NULL);
+
+    return true;
 }
 
 
@@ -453,8 +1090,21 @@ Font& Font::operator =(const Font& right)
     std::swap(m_stroker,     temp.m_stroker);
     std::swap(m_refCount,    temp.m_refCount);
     std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
+    std::swap(m_atlases,     temp.m_atlases);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_sharedAtlas, temp.m_sharedAtlas);
+    std::swap(m_atlasLimit,  temp.m_atlasLimit);
+    std::swap(m_budget,      temp.m_budget);
+    std::swap(m_atlasClock,  temp.m_atlasClock);
+    std::swap(m_cacheHits,   temp.m_cacheHits);
+    std::swap(m_cacheMisses, temp.m_cacheMisses);
+    std::swap(m_releases,    temp.m_releases);
+    std::swap(m_evictions,   temp.m_evictions);
+    std::swap(m_sdfEnabled,  temp.m_sdfEnabled);
+    std::swap(m_sdfShader,   temp.m_sdfShader);
+    std::swap(m_kerning,     temp.m_kerning);
+    std::swap(m_fileName,    temp.m_fileName);
+    std::swap(m_tickets,     temp.m_tickets);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -467,6 +1117,12 @@ Font& Font::operator =(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Cancel the pending glyph requests, whose workers may be using the font data
+    TicketList tickets;
+    tickets.swap(m_tickets);
+    for (TicketList::iterator it = tickets.begin(); it != tickets.end(); ++it)
+        (*it)->cancel();
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -503,8 +1159,19 @@ void Font::cleanup()
     m_stroker   = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
-    m_pages.clear();
+    m_fileName.clear();
     m_pixelBuffer.clear();
+    clearAtlases();
+
+    // Restart the statistics of the cache
+    m_cacheHits   = 0;
+    m_cacheMisses = 0;
+    m_releases    = 0;
+    m_evictions   = 0;
+
+    // Forget the kerning of the previous font
+    delete m_kerning;
+    m_kerning = NULL;
 }
 
 
@@ -523,198 +1190,263 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
-
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+    // Rasterize the glyph
+    unsigned int width  = 0;
+    unsigned int height = 0;
+    int spread = m_sdfEnabled ? distanceFieldSpread : 0;
+    if (!priv::GlyphRasterizer::rasterize(m_library, m_face, m_stroker, spread, codePoint, bold, outlineThickness, glyph, m_pixelBuffer, width, height))
         return glyph;
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
+    if ((width > 0) && (height > 0))
     {
-        if (bold)
+        // Get the glyph atlas corresponding to the character size
+        priv::GlyphAtlas& atlas = getAtlas(characterSize);
+
+        // Find a good position for the new glyph into the texture
+        if (!atlas.allocate(width, height, glyph.textureRect))
         {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+            glyph.bounds = FloatRect();
+            return glyph;
         }
 
-        if (outlineThickness != 0)
-        {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
+        // Write the pixels to the texture
+        unsigned int x = glyph.textureRect.left;
+        unsigned int y = glyph.textureRect.top;
+        unsigned int w = glyph.textureRect.width;
+        unsigned int h = glyph.textureRect.height;
+        atlas.getTexture().update(&m_pixelBuffer[0], w, h, x, y);
 
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, false);
-        }
+        // The texture may have grown beyond the budget
+        applyMemoryBudget(&atlas);
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    // Done :)
+    return glyph;
+}
+
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(priv::GlyphAtlas& atlas, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    // The glyph is rasterized once at the reference size, with
+    // an outline scaled accordingly
+    float scale = static_cast<float>(characterSize) / distanceFieldSize;
+    float referenceThickness = (scale > 0) ? outlineThickness / scale : outlineThickness;
+
+    priv::GlyphAtlas::Key referenceKey(distanceFieldSize, glyphKey(codePoint, bold, referenceThickness));
+    const Glyph* reference = atlas.find(referenceKey);
+    if (reference)
+    {
+        m_cacheHits++;
+    }
+    else
     {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        m_cacheMisses++;
+        reference = &atlas.insert(referenceKey, loadGlyph(codePoint, distanceFieldSize, bold, referenceThickness));
+    }
+
+    if (characterSize == distanceFieldSize)
+        return *reference;
+
+    // Other sizes use the same pixels, with scaled metrics; the scaled glyph
+    // is still valid as long as the reference glyph has not been reloaded elsewhere
+    priv::GlyphAtlas::Key key(characterSize, glyphKey(codePoint, bold, outlineThickness));
+    const Glyph* glyph = atlas.find(key);
+    if (glyph && (glyph->textureRect == reference->textureRect))
+        return *glyph;
+
+    Glyph scaled;
+    scaled.advance     = reference->advance * scale;
+    scaled.bounds      = FloatRect(reference->bounds.left * scale, reference->bounds.top * scale, reference->bounds.width * scale, reference->bounds.height * scale);
+    scaled.textureRect = reference->textureRect;
 
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+    return atlas.insert(key, scaled, true);
+}
+
+
+////////////////////////////////////////////////////////////
+priv::GlyphAtlas& Font::getAtlas(unsigned int characterSize) const
+{
+    // All the sizes share the same atlas, if enabled (distance field glyphs are always shared)
+    if (m_sharedAtlas || m_sdfEnabled)
+        characterSize = 0;
+
+    priv::GlyphAtlas*& atlas = m_atlases[characterSize];
+    if (!atlas)
+    {
+        atlas = new priv::GlyphAtlas;
+        atlas->setMemoryLimit(getEffectiveAtlasLimit());
     }
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+    // Remember the use, so that the least recently used atlases are released first
+    atlas->setLastUse(++m_atlasClock);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+    return *atlas;
+}
 
-    if ((width > 0) && (height > 0))
+
+////////////////////////////////////////////////////////////
+Uint64 Font::getGlyphGeneration(unsigned int characterSize) const
+{
+    return getAtlas(characterSize).getGeneration();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::addRasterizedGlyphs(priv::GlyphRasterizer& rasterizer) const
+{
+    // The glyphs are useless if the distance field mode was toggled since the request
+    if ((rasterizer.getSpread() > 0) != m_sdfEnabled)
+        return;
+
+    unsigned int rasterSize = rasterizer.getCharacterSize();
+    priv::GlyphAtlas& atlas = getAtlas(rasterSize);
+
+    // Glyphs without pixels are added directly; the others are
+    // added once their place in the texture is known. Glyphs loaded
+    // in the meantime (on demand, by the font) are ignored.
+    std::vector<priv::GlyphRasterizer::Job*> pending;
+    std::vector<Vector2u> sizes;
+    std::vector<priv::GlyphRasterizer::Job>& jobs = rasterizer.getJobs();
+    for (std::vector<priv::GlyphRasterizer::Job>::iterator it = jobs.begin(); it != jobs.end(); ++it)
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
+        priv::GlyphAtlas::Key key(rasterSize, glyphKey(it->codePoint, it->bold, it->outlineThickness));
+        if (!it->done || atlas.find(key))
+            continue;
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        if ((it->width > 0) && (it->height > 0))
+        {
+            pending.push_back(&*it);
+            sizes.push_back(Vector2u(it->width, it->height));
+        }
+        else
+        {
+            atlas.insert(key, it->glyph);
+        }
+    }
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
-
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
-
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+    if (pending.empty())
+        return;
+
+    // Pack all the glyphs in a single block, and write them with a single update
+    std::vector<IntRect> rects;
+    IntRect block;
+    if (atlas.allocate(sizes, rects, block))
+    {
+        m_pixelBuffer.resize(block.width * block.height * 4);
+        for (std::size_t i = 0; i < m_pixelBuffer.size(); i += 4)
         {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
+            m_pixelBuffer[i + 0] = 255;
+            m_pixelBuffer[i + 1] = 255;
+            m_pixelBuffer[i + 2] = 255;
+            m_pixelBuffer[i + 3] = 0;
+        }
+
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            const priv::GlyphRasterizer::Job& job = *pending[i];
+            const IntRect& rect = rects[i];
+            for (unsigned int y = 0; y < job.height; ++y)
             {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
+                const Uint8* source = &job.pixels[y * job.width * 4];
+                Uint8* destination = &m_pixelBuffer[((rect.top - block.top + y) * block.width + (rect.left - block.left)) * 4];
+                std::memcpy(destination, source, job.width * 4);
             }
+
+            Glyph glyph = job.glyph;
+            glyph.textureRect = rect;
+            atlas.insert(priv::GlyphAtlas::Key(rasterSize, glyphKey(job.codePoint, job.bold, job.outlineThickness)), glyph);
         }
-        else
+
+        atlas.getTexture().update(&m_pixelBuffer[0], block.width, block.height, block.left, block.top);
+        applyMemoryBudget(&atlas);
+    }
+    else
+    {
+        // The block doesn't fit: add the glyphs one by one, evicting older ones if needed
+        for (std::size_t i = 0; i < pending.size(); ++i)
         {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
+            const priv::GlyphRasterizer::Job& job = *pending[i];
+
+            Glyph glyph = job.glyph;
+            if (!atlas.allocate(job.width, job.height, glyph.textureRect))
             {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
+                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+                return;
             }
+
+            atlas.getTexture().update(&job.pixels[0], job.width, job.height, glyph.textureRect.left, glyph.textureRect.top);
+            atlas.insert(priv::GlyphAtlas::Key(rasterSize, glyphKey(job.codePoint, job.bold, job.outlineThickness)), glyph);
         }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left;
-        unsigned int y = glyph.textureRect.top;
-        unsigned int w = glyph.textureRect.width;
-        unsigned int h = glyph.textureRect.height;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+        applyMemoryBudget(&atlas);
     }
+}
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
 
-    // Done :)
-    return glyph;
+////////////////////////////////////////////////////////////
+void Font::removeTicket(GlyphTicket* ticket) const
+{
+    m_tickets.erase(std::remove(m_tickets.begin(), m_tickets.end(), ticket), m_tickets.end());
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+void Font::clearAtlases()
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    for (AtlasTable::iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+        delete it->second;
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+    m_atlases.clear();
+}
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+////////////////////////////////////////////////////////////
+std::size_t Font::getEffectiveAtlasLimit() const
+{
+    if (m_atlasLimit == 0)
+        return m_budget;
+    if (m_budget == 0)
+        return m_atlasLimit;
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
+    return std::min(m_atlasLimit, m_budget);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::applyMemoryBudget(const priv::GlyphAtlas* current) const
+{
+    if (m_budget == 0)
+        return;
+
+    std::size_t usage = 0;
+    for (AtlasTable::const_iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
+        usage += it->second->getMemoryUsage();
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    // Release the least recently used atlases, except the one being filled and the
+    // ones that draw queues still refer to (they are released on a later call);
+    // the pending batches of render targets are flushed by the atlas destructor
+    while (usage > m_budget)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        AtlasTable::iterator oldest = m_atlases.end();
+        for (AtlasTable::iterator it = m_atlases.begin(); it != m_atlases.end(); ++it)
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
-            }
-            else
-            {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
-            }
+            if ((it->second != current) && ((oldest == m_atlases.end()) || (it->second->getLastUse() < oldest->second->getLastUse()))
+                && !DrawQueue::isRecorded(it->second->getTexture()))
+                oldest = it;
         }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
-    }
-
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+        if (oldest == m_atlases.end())
+            break;
 
-    // Update the row informations
-    row->width += width;
+        usage -= oldest->second->getMemoryUsage();
+        m_evictions += oldest->second->getEvictionCount();
+        m_releases++;
 
-    return rect;
+        delete oldest->second;
+        m_atlases.erase(oldest);
+    }
 }
 
 
@@ -753,23 +1485,4 @@ bool Font::setCurrentSize(unsigned int characterSize) const
     }
 }
 
-
-////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
-{
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
-
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
-
-    // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
-}
-
 } // namespace sf
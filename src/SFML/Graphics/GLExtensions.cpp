@@ -84,6 +84,15 @@ void ensureExtensionsInit()
             err() << "sfml-graphics requires support for OpenGL 1.1 or greater" << std::endl;
             err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
         }
+
+        // Core profiles don't advertise the extensions of features that became core,
+        // so enable them from the version: clamp-to-edge is core since OpenGL 1.2...
+        if ((majorVersion > 1) || ((majorVersion == 1) && (minorVersion >= 2)))
+            sfogl_ext_SGIS_texture_edge_clamp = sfogl_LOAD_SUCCEEDED;
+
+        // ... and framebuffer objects since OpenGL 3.0, with the entry points of ARB_framebuffer_object
+        if ((majorVersion >= 3) && !sfogl_ext_ARB_framebuffer_object)
+            sfogl_LoadExtension("GL_ARB_framebuffer_object");
     }
 #endif
 }
@@ -53,6 +53,18 @@
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
 
+    // Core since 1.1 - vertex buffer objects
+    #define GLEXT_vertex_buffer_object                true
+    #define GLEXT_glBindBuffer                        glBindBuffer
+    #define GLEXT_glBufferData                        glBufferData
+    #define GLEXT_glBufferSubData                     glBufferSubData
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffers
+    #define GLEXT_glGenBuffers                        glGenBuffers
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
+    #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW // GL_STREAM_DRAW is only core since ES 2.0
+
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
     // functions according to the corresponding specification
@@ -120,6 +132,20 @@
         #define GLEXT_GL_SRGB8_ALPHA8                     0
     #endif
 
+    // Core since 3.0 - EXT_draw_instanced / EXT_instanced_arrays
+    #define GLEXT_draw_instanced                      false
+    #define GLEXT_instanced_arrays                    false
+
+    // Core since 3.0 - NV_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+
+    // Core since 3.0 - EXT_map_buffer_range / sync objects
+    #define GLEXT_map_buffer_range                    false
+    #define GLEXT_sync                                false
+
+    // Core since 3.2 - EXT_buffer_storage
+    #define GLEXT_buffer_storage                      false
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -165,6 +191,24 @@
     #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
 
+    // Core since 1.5 - ARB_vertex_buffer_object
+    #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
+    #define GLEXT_glBindBuffer                        glBindBufferARB
+    #define GLEXT_glBufferData                        glBufferDataARB
+    #define GLEXT_glBufferSubData                     glBufferSubDataARB
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
+    #define GLEXT_glGenBuffers                        glGenBuffersARB
+    #define GLEXT_glGetBufferSubData                  glGetBufferSubDataARB
+    #define GLEXT_glMapBuffer                         glMapBufferARB
+    #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
+    #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
+    #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
+    #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -205,6 +249,10 @@
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
     // Core since 2.0 - ARB_fragment_shader
@@ -222,19 +270,25 @@
     #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
 
-    // Core since 3.0 - EXT_framebuffer_object
-    #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
-    #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
-    #define GLEXT_glDeleteRenderbuffers               glDeleteRenderbuffersEXT
-    #define GLEXT_glGenRenderbuffers                  glGenRenderbuffersEXT
-    #define GLEXT_glRenderbufferStorage               glRenderbufferStorageEXT
-    #define GLEXT_glBindFramebuffer                   glBindFramebufferEXT
-    #define GLEXT_glDeleteFramebuffers                glDeleteFramebuffersEXT
-    #define GLEXT_glGenFramebuffers                   glGenFramebuffersEXT
-    #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatusEXT
-    #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2DEXT
-    #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbufferEXT
-    #define GLEXT_glGenerateMipmap                    glGenerateMipmapEXT
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 sfogl_ext_ARB_pixel_buffer_object
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER_ARB
+
+    // Core since 3.0 - EXT_framebuffer_object, or ARB_framebuffer_object which core contexts
+    // may expose alone; both have the same functions and tokens, the ARB (core) ones are preferred
+    #define GLEXT_framebuffer_object                  (sfogl_ext_ARB_framebuffer_object || sfogl_ext_EXT_framebuffer_object)
+    #define GLEXT_glBindRenderbuffer                  (sfogl_ext_ARB_framebuffer_object ? glBindRenderbuffer : glBindRenderbufferEXT)
+    #define GLEXT_glDeleteRenderbuffers               (sfogl_ext_ARB_framebuffer_object ? glDeleteRenderbuffers : glDeleteRenderbuffersEXT)
+    #define GLEXT_glGenRenderbuffers                  (sfogl_ext_ARB_framebuffer_object ? glGenRenderbuffers : glGenRenderbuffersEXT)
+    #define GLEXT_glRenderbufferStorage               (sfogl_ext_ARB_framebuffer_object ? glRenderbufferStorage : glRenderbufferStorageEXT)
+    #define GLEXT_glBindFramebuffer                   (sfogl_ext_ARB_framebuffer_object ? glBindFramebuffer : glBindFramebufferEXT)
+    #define GLEXT_glDeleteFramebuffers                (sfogl_ext_ARB_framebuffer_object ? glDeleteFramebuffers : glDeleteFramebuffersEXT)
+    #define GLEXT_glGenFramebuffers                   (sfogl_ext_ARB_framebuffer_object ? glGenFramebuffers : glGenFramebuffersEXT)
+    #define GLEXT_glCheckFramebufferStatus            (sfogl_ext_ARB_framebuffer_object ? glCheckFramebufferStatus : glCheckFramebufferStatusEXT)
+    #define GLEXT_glFramebufferTexture2D              (sfogl_ext_ARB_framebuffer_object ? glFramebufferTexture2D : glFramebufferTexture2DEXT)
+    #define GLEXT_glFramebufferRenderbuffer           (sfogl_ext_ARB_framebuffer_object ? glFramebufferRenderbuffer : glFramebufferRenderbufferEXT)
+    #define GLEXT_glGenerateMipmap                    (sfogl_ext_ARB_framebuffer_object ? glGenerateMipmap : glGenerateMipmapEXT)
     #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER_EXT
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_EXT
     #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0_EXT
@@ -243,10 +297,48 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
 
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    sfogl_ext_ARB_map_buffer_range
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+    #define GLEXT_glFlushMappedBufferRange            glFlushMappedBufferRange
+    #define GLEXT_GL_MAP_READ_BIT                     GL_MAP_READ_BIT
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GLEXT_GL_MAP_FLUSH_EXPLICIT_BIT           GL_MAP_FLUSH_EXPLICIT_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_ext_ARB_sync
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 4.4 - ARB_buffer_storage
+    #define GLEXT_buffer_storage                      sfogl_ext_ARB_buffer_storage
+    #define GLEXT_glBufferStorage                     glBufferStorage
+    #define GLEXT_GL_MAP_PERSISTENT_BIT               GL_MAP_PERSISTENT_BIT
+    #define GLEXT_GL_MAP_COHERENT_BIT                 GL_MAP_COHERENT_BIT
+
 #endif
 
 namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLLoader.hpp>
 #include <SFML/Window/Context.hpp>
+#include <cstring>
 
 static sf::GlFunctionPointer glLoaderGetProcAddress(const char* name)
 {
@@ -48,6 +49,14 @@ int sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_buffer_storage = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_framebuffer_object = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -828,6 +837,282 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void*, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void**) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum) = NULL;
+
+static int Load_ARB_vertex_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindBufferARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBufferARB"));
+    if (!sf_ptrc_glBindBufferARB)
+        numFailed++;
+
+    sf_ptrc_glBufferDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptrARB, const void*, GLenum)>(glLoaderGetProcAddress("glBufferDataARB"));
+    if (!sf_ptrc_glBufferDataARB)
+        numFailed++;
+
+    sf_ptrc_glBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, const void*)>(glLoaderGetProcAddress("glBufferSubDataARB"));
+    if (!sf_ptrc_glBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffersARB"));
+    if (!sf_ptrc_glDeleteBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGenBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffersARB"));
+    if (!sf_ptrc_glGenBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferParameterivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetBufferParameterivARB"));
+    if (!sf_ptrc_glGetBufferParameterivARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferPointervARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, void**)>(glLoaderGetProcAddress("glGetBufferPointervARB"));
+    if (!sf_ptrc_glGetBufferPointervARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, void*)>(glLoaderGetProcAddress("glGetBufferSubDataARB"));
+    if (!sf_ptrc_glGetBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glIsBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsBufferARB"));
+    if (!sf_ptrc_glIsBufferARB)
+        numFailed++;
+
+    sf_ptrc_glMapBufferARB = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLenum)>(glLoaderGetProcAddress("glMapBufferARB"));
+    if (!sf_ptrc_glMapBufferARB)
+        numFailed++;
+
+    sf_ptrc_glUnmapBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glUnmapBufferARB"));
+    if (!sf_ptrc_glUnmapBufferARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+
+static int Load_ARB_map_buffer_range()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glFlushMappedBufferRange = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr)>(glLoaderGetProcAddress("glFlushMappedBufferRange"));
+    if (!sf_ptrc_glFlushMappedBufferRange)
+        numFailed++;
+
+    sf_ptrc_glMapBufferRange = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, GLbitfield)>(glLoaderGetProcAddress("glMapBufferRange"));
+    if (!sf_ptrc_glMapBufferRange)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glGetInteger64v = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint64*)>(glLoaderGetProcAddress("glGetInteger64v"));
+    if (!sf_ptrc_glGetInteger64v)
+        numFailed++;
+
+    sf_ptrc_glGetSynciv = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei*, GLint*)>(glLoaderGetProcAddress("glGetSynciv"));
+    if (!sf_ptrc_glGetSynciv)
+        numFailed++;
+
+    sf_ptrc_glIsSync = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glIsSync"));
+    if (!sf_ptrc_glIsSync)
+        numFailed++;
+
+    sf_ptrc_glWaitSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glWaitSync"));
+    if (!sf_ptrc_glWaitSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield) = NULL;
+
+static int Load_ARB_buffer_storage()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBufferStorage = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptr, const void*, GLbitfield)>(glLoaderGetProcAddress("glBufferStorage"));
+    if (!sf_ptrc_glBufferStorage)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindFramebuffer)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindRenderbuffer)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBlitFramebuffer)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum) = NULL;
+GLenum (GL_FUNCPTR *sf_ptrc_glCheckFramebufferStatus)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteFramebuffers)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteRenderbuffers)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFramebufferRenderbuffer)(GLenum, GLenum, GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture1D)(GLenum, GLenum, GLenum, GLuint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture2D)(GLenum, GLenum, GLenum, GLuint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture3D)(GLenum, GLenum, GLenum, GLuint, GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glFramebufferTextureLayer)(GLenum, GLenum, GLuint, GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenFramebuffers)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenRenderbuffers)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenerateMipmap)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetFramebufferAttachmentParameteriv)(GLenum, GLenum, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetRenderbufferParameteriv)(GLenum, GLenum, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsFramebuffer)(GLuint) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsRenderbuffer)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorage)(GLenum, GLenum, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisample)(GLenum, GLsizei, GLenum, GLsizei, GLsizei) = NULL;
+
+static int Load_ARB_framebuffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindFramebuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindFramebuffer"));
+    if (!sf_ptrc_glBindFramebuffer)
+        numFailed++;
+
+    sf_ptrc_glBindRenderbuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindRenderbuffer"));
+    if (!sf_ptrc_glBindRenderbuffer)
+        numFailed++;
+
+    sf_ptrc_glBlitFramebuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum)>(glLoaderGetProcAddress("glBlitFramebuffer"));
+    if (!sf_ptrc_glBlitFramebuffer)
+        numFailed++;
+
+    sf_ptrc_glCheckFramebufferStatus = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glCheckFramebufferStatus"));
+    if (!sf_ptrc_glCheckFramebufferStatus)
+        numFailed++;
+
+    sf_ptrc_glDeleteFramebuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteFramebuffers"));
+    if (!sf_ptrc_glDeleteFramebuffers)
+        numFailed++;
+
+    sf_ptrc_glDeleteRenderbuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteRenderbuffers"));
+    if (!sf_ptrc_glDeleteRenderbuffers)
+        numFailed++;
+
+    sf_ptrc_glFramebufferRenderbuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint)>(glLoaderGetProcAddress("glFramebufferRenderbuffer"));
+    if (!sf_ptrc_glFramebufferRenderbuffer)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture1D = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture1D"));
+    if (!sf_ptrc_glFramebufferTexture1D)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture2D = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture2D"));
+    if (!sf_ptrc_glFramebufferTexture2D)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTexture3D = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLuint, GLint, GLint)>(glLoaderGetProcAddress("glFramebufferTexture3D"));
+    if (!sf_ptrc_glFramebufferTexture3D)
+        numFailed++;
+
+    sf_ptrc_glFramebufferTextureLayer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLuint, GLint, GLint)>(glLoaderGetProcAddress("glFramebufferTextureLayer"));
+    if (!sf_ptrc_glFramebufferTextureLayer)
+        numFailed++;
+
+    sf_ptrc_glGenFramebuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenFramebuffers"));
+    if (!sf_ptrc_glGenFramebuffers)
+        numFailed++;
+
+    sf_ptrc_glGenRenderbuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenRenderbuffers"));
+    if (!sf_ptrc_glGenRenderbuffers)
+        numFailed++;
+
+    sf_ptrc_glGenerateMipmap = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glGenerateMipmap"));
+    if (!sf_ptrc_glGenerateMipmap)
+        numFailed++;
+
+    sf_ptrc_glGetFramebufferAttachmentParameteriv = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetFramebufferAttachmentParameteriv"));
+    if (!sf_ptrc_glGetFramebufferAttachmentParameteriv)
+        numFailed++;
+
+    sf_ptrc_glGetRenderbufferParameteriv = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetRenderbufferParameteriv"));
+    if (!sf_ptrc_glGetRenderbufferParameteriv)
+        numFailed++;
+
+    sf_ptrc_glIsFramebuffer = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsFramebuffer"));
+    if (!sf_ptrc_glIsFramebuffer)
+        numFailed++;
+
+    sf_ptrc_glIsRenderbuffer = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsRenderbuffer"));
+    if (!sf_ptrc_glIsRenderbuffer)
+        numFailed++;
+
+    sf_ptrc_glRenderbufferStorage = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLsizei, GLsizei)>(glLoaderGetProcAddress("glRenderbufferStorage"));
+    if (!sf_ptrc_glRenderbufferStorage)
+        numFailed++;
+
+    sf_ptrc_glRenderbufferStorageMultisample = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, GLsizei, GLsizei)>(glLoaderGetProcAddress("glRenderbufferStorageMultisample"));
+    if (!sf_ptrc_glRenderbufferStorageMultisample)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -836,7 +1121,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[15] = {
+static sfogl_StrToExtMap ExtensionMap[23] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -851,10 +1136,18 @@ static sfogl_StrToExtMap ExtensionMap[15] = {
     {"GL_EXT_blend_equation_separate", &sfogl_ext_EXT_blend_equation_separate, Load_EXT_blend_equation_separate},
     {"GL_EXT_texture_sRGB", &sfogl_ext_EXT_texture_sRGB, NULL},
     {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_vertex_buffer_object", &sfogl_ext_ARB_vertex_buffer_object, Load_ARB_vertex_buffer_object},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_map_buffer_range", &sfogl_ext_ARB_map_buffer_range, Load_ARB_map_buffer_range},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_buffer_storage", &sfogl_ext_ARB_buffer_storage, Load_ARB_buffer_storage},
+    {"GL_ARB_pixel_buffer_object", &sfogl_ext_ARB_pixel_buffer_object, NULL},
+    {"GL_ARB_framebuffer_object", &sfogl_ext_ARB_framebuffer_object, Load_ARB_framebuffer_object}
 };
 
-static int g_extensionMapSize = 15;
+static int g_extensionMapSize = 23;
 
 
 static void ClearExtensionVars()
@@ -874,6 +1167,14 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_buffer_storage = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_framebuffer_object = sfogl_LOAD_FAILED;
 }
 
 
@@ -900,3 +1201,13 @@ void sfogl_LoadFunctions()
             LoadExtension(ExtensionMap[i]);
     }
 }
+
+
+void sfogl_LoadExtension(const char* extensionName)
+{
+    for (int i = 0; i < g_extensionMapSize; ++i)
+    {
+        if (std::strcmp(ExtensionMap[i].extensionName, extensionName) == 0)
+            LoadExtension(ExtensionMap[i]);
+    }
+}
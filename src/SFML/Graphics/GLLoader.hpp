@@ -185,6 +185,14 @@ extern int sfogl_ext_EXT_blend_equation_separate;
 extern int sfogl_ext_EXT_texture_sRGB;
 extern int sfogl_ext_EXT_framebuffer_object;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_vertex_buffer_object;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_map_buffer_range;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_buffer_storage;
+extern int sfogl_ext_ARB_pixel_buffer_object;
+extern int sfogl_ext_ARB_framebuffer_object;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -400,6 +408,69 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_ARRAY_BUFFER_ARB 0x8892
+#define GL_ARRAY_BUFFER_BINDING_ARB 0x8894
+#define GL_BUFFER_ACCESS_ARB 0x88BB
+#define GL_BUFFER_MAPPED_ARB 0x88BC
+#define GL_BUFFER_MAP_POINTER_ARB 0x88BD
+#define GL_BUFFER_SIZE_ARB 0x8764
+#define GL_BUFFER_USAGE_ARB 0x8765
+#define GL_COLOR_ARRAY_BUFFER_BINDING_ARB 0x8898
+#define GL_DYNAMIC_COPY_ARB 0x88EA
+#define GL_DYNAMIC_DRAW_ARB 0x88E8
+#define GL_DYNAMIC_READ_ARB 0x88E9
+#define GL_ELEMENT_ARRAY_BUFFER_ARB 0x8893
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB 0x8895
+#define GL_READ_ONLY_ARB 0x88B8
+#define GL_READ_WRITE_ARB 0x88BA
+#define GL_STATIC_COPY_ARB 0x88E6
+#define GL_STATIC_DRAW_ARB 0x88E4
+#define GL_STATIC_READ_ARB 0x88E5
+#define GL_STREAM_COPY_ARB 0x88E2
+#define GL_STREAM_DRAW_ARB 0x88E0
+#define GL_STREAM_READ_ARB 0x88E1
+#define GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING_ARB 0x889A
+#define GL_VERTEX_ARRAY_BUFFER_BINDING_ARB 0x8896
+#define GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING_ARB 0x889F
+#define GL_WRITE_ONLY_ARB 0x88B9
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_MAP_PERSISTENT_BIT 0x0040
+
+#define GL_PIXEL_PACK_BUFFER_ARB 0x88EB
+#define GL_PIXEL_PACK_BUFFER_BINDING_ARB 0x88ED
+#define GL_PIXEL_UNPACK_BUFFER_ARB 0x88EC
+#define GL_PIXEL_UNPACK_BUFFER_BINDING_ARB 0x88EF
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1254,6 +1325,122 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_vertex_buffer_object
+#define GL_ARB_vertex_buffer_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint);
+#define glBindBufferARB sf_ptrc_glBindBufferARB
+extern void (GL_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void*, GLenum);
+#define glBufferDataARB sf_ptrc_glBufferDataARB
+extern void (GL_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void*);
+#define glBufferSubDataARB sf_ptrc_glBufferSubDataARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint*);
+#define glDeleteBuffersARB sf_ptrc_glDeleteBuffersARB
+extern void (GL_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint*);
+#define glGenBuffersARB sf_ptrc_glGenBuffersARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint*);
+#define glGetBufferParameterivARB sf_ptrc_glGetBufferParameterivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void**);
+#define glGetBufferPointervARB sf_ptrc_glGetBufferPointervARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void*);
+#define glGetBufferSubDataARB sf_ptrc_glGetBufferSubDataARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint);
+#define glIsBufferARB sf_ptrc_glIsBufferARB
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum);
+#define glMapBufferARB sf_ptrc_glMapBufferARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum);
+#define glUnmapBufferARB sf_ptrc_glUnmapBufferARB
+#endif // GL_ARB_vertex_buffer_object
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif // GL_ARB_draw_instanced
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif // GL_ARB_instanced_arrays
+
+#ifndef GL_ARB_map_buffer_range
+#define GL_ARB_map_buffer_range 1
+extern void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr);
+#define glFlushMappedBufferRange sf_ptrc_glFlushMappedBufferRange
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+#define glMapBufferRange sf_ptrc_glMapBufferRange
+#endif // GL_ARB_map_buffer_range
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif // GL_ARB_sync
+
+#ifndef GL_ARB_buffer_storage
+#define GL_ARB_buffer_storage 1
+extern void (GL_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield);
+#define glBufferStorage sf_ptrc_glBufferStorage
+#endif // GL_ARB_buffer_storage
+
+#ifndef GL_ARB_framebuffer_object
+#define GL_ARB_framebuffer_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindFramebuffer)(GLenum, GLuint);
+#define glBindFramebuffer sf_ptrc_glBindFramebuffer
+extern void (GL_FUNCPTR *sf_ptrc_glBindRenderbuffer)(GLenum, GLuint);
+#define glBindRenderbuffer sf_ptrc_glBindRenderbuffer
+extern void (GL_FUNCPTR *sf_ptrc_glBlitFramebuffer)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+#define glBlitFramebuffer sf_ptrc_glBlitFramebuffer
+extern GLenum (GL_FUNCPTR *sf_ptrc_glCheckFramebufferStatus)(GLenum);
+#define glCheckFramebufferStatus sf_ptrc_glCheckFramebufferStatus
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteFramebuffers)(GLsizei, const GLuint*);
+#define glDeleteFramebuffers sf_ptrc_glDeleteFramebuffers
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteRenderbuffers)(GLsizei, const GLuint*);
+#define glDeleteRenderbuffers sf_ptrc_glDeleteRenderbuffers
+extern void (GL_FUNCPTR *sf_ptrc_glFramebufferRenderbuffer)(GLenum, GLenum, GLenum, GLuint);
+#define glFramebufferRenderbuffer sf_ptrc_glFramebufferRenderbuffer
+extern void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture1D)(GLenum, GLenum, GLenum, GLuint, GLint);
+#define glFramebufferTexture1D sf_ptrc_glFramebufferTexture1D
+extern void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture2D)(GLenum, GLenum, GLenum, GLuint, GLint);
+#define glFramebufferTexture2D sf_ptrc_glFramebufferTexture2D
+extern void (GL_FUNCPTR *sf_ptrc_glFramebufferTexture3D)(GLenum, GLenum, GLenum, GLuint, GLint, GLint);
+#define glFramebufferTexture3D sf_ptrc_glFramebufferTexture3D
+extern void (GL_FUNCPTR *sf_ptrc_glFramebufferTextureLayer)(GLenum, GLenum, GLuint, GLint, GLint);
+#define glFramebufferTextureLayer sf_ptrc_glFramebufferTextureLayer
+extern void (GL_FUNCPTR *sf_ptrc_glGenFramebuffers)(GLsizei, GLuint*);
+#define glGenFramebuffers sf_ptrc_glGenFramebuffers
+extern void (GL_FUNCPTR *sf_ptrc_glGenRenderbuffers)(GLsizei, GLuint*);
+#define glGenRenderbuffers sf_ptrc_glGenRenderbuffers
+extern void (GL_FUNCPTR *sf_ptrc_glGenerateMipmap)(GLenum);
+#define glGenerateMipmap sf_ptrc_glGenerateMipmap
+extern void (GL_FUNCPTR *sf_ptrc_glGetFramebufferAttachmentParameteriv)(GLenum, GLenum, GLenum, GLint*);
+#define glGetFramebufferAttachmentParameteriv sf_ptrc_glGetFramebufferAttachmentParameteriv
+extern void (GL_FUNCPTR *sf_ptrc_glGetRenderbufferParameteriv)(GLenum, GLenum, GLint*);
+#define glGetRenderbufferParameteriv sf_ptrc_glGetRenderbufferParameteriv
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsFramebuffer)(GLuint);
+#define glIsFramebuffer sf_ptrc_glIsFramebuffer
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsRenderbuffer)(GLuint);
+#define glIsRenderbuffer sf_ptrc_glIsRenderbuffer
+extern void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorage)(GLenum, GLenum, GLsizei, GLsizei);
+#define glRenderbufferStorage sf_ptrc_glRenderbufferStorage
+extern void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisample)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+#define glRenderbufferStorageMultisample sf_ptrc_glRenderbufferStorageMultisample
+#endif // GL_ARB_framebuffer_object
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -1599,6 +1786,7 @@ enum sfogl_LoadStatus
 };
 
 void sfogl_LoadFunctions();
+void sfogl_LoadExtension(const char* extensionName);
 
 #ifdef __cplusplus
 }
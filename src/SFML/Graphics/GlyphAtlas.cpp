@@ -0,0 +1,536 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphAtlas.hpp>
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Transparent pixels kept around each glyph, so that
+    // filtering doesn't pollute it with pixels from its neighbours
+    const unsigned int padding = 1;
+
+    // Number of sizes and styles whose Latin-1 glyphs are indexed directly
+    const std::size_t latinPageCount = 4;
+
+    // Bits of a glyph key holding the code point
+    const sf::Uint64 codePointMask = 0x7FFFFFFF;
+
+    // Thread-safe generator of atlas generations
+    sf::Mutex generationMutex;
+    sf::Uint64 getUniqueGeneration()
+    {
+        sf::Lock lock(generationMutex);
+
+        static sf::Uint64 generation = 1;
+
+        return generation++;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphAtlas::GlyphAtlas() :
+m_slots      (),
+m_freeSlots  (),
+m_index      (),
+m_latinPages (),
+m_nextPage   (0),
+m_packer     (),
+m_texture    (),
+m_memoryLimit(0),
+m_clock      (0),
+m_generation (getUniqueGeneration()),
+m_evictions  (0),
+m_lastUse    (0)
+{
+    // Make sure that the texture is initialized by default
+    Image image;
+    image.create(128, 128, Color(255, 255, 255, 0));
+
+    // Reserve a 2x2 white square for texturing underlines
+    for (int x = 0; x < 2; ++x)
+        for (int y = 0; y < 2; ++y)
+            image.setPixel(x, y, Color(255, 255, 255, 255));
+
+    // Create the texture
+    m_texture.loadFromImage(image);
+    m_texture.setSmooth(true);
+
+    // The white square (and its padding) is the first rectangle of
+    // the packer, which places it at the top-left corner
+    IntRect square;
+    m_packer.reset(128, 128);
+    m_packer.insert(2 + padding, 2 + padding, square);
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphAtlas::~GlyphAtlas()
+{
+    // Render the pending primitives that use the texture while it still exists
+    RenderTarget::flushBatches(m_texture);
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph* GlyphAtlas::find(const Key& key)
+{
+    Uint64 codePoint = key.second & codePointMask;
+    LatinPage* page = (codePoint < 256) ? &getLatinPage(key) : NULL;
+
+    // Fast path: Latin-1 glyph indexed directly (the slot may
+    // have been reused by another glyph since it was indexed)
+    Uint32 index = page ? page->slots[codePoint] : 0;
+    if ((index > 0) && m_slots[index - 1].used && (m_slots[index - 1].entry.key == key))
+    {
+        index -= 1;
+    }
+    else
+    {
+        const Uint32* found = m_index.find(key);
+        if (!found)
+            return NULL;
+
+        index = *found;
+        if (page)
+            page->slots[codePoint] = index + 1;
+    }
+
+    Entry& entry = m_slots[index].entry;
+    entry.lastUse = ++m_clock;
+
+    return &entry.glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& GlyphAtlas::insert(const Key& key, const Glyph& glyph, bool alias)
+{
+    // Replace the glyph if it is already there, otherwise use a new slot
+    Uint32 index;
+    const Uint32* found = m_index.find(key);
+    if (found)
+    {
+        index = *found;
+    }
+    else if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_index.insert(key, index);
+    }
+    else
+    {
+        index = static_cast<Uint32>(m_slots.size());
+        m_slots.push_back(Slot());
+        m_index.insert(key, index);
+    }
+
+    Slot& slot = m_slots[index];
+    slot.used = true;
+    slot.entry.key = key;
+    slot.entry.glyph = glyph;
+    slot.entry.lastUse = ++m_clock;
+    slot.entry.alias = alias;
+
+    return slot.entry.glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::allocate(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Don't throw away the whole atlas for a glyph that can never fit
+    if ((width + 2 * padding > Texture::getMaximumSize()) || (height + 2 * padding > Texture::getMaximumSize()))
+        return false;
+
+    // Try to place the glyph; when there's no room left, first
+    // enlarge the texture, then evict the oldest glyphs; if they
+    // can't be evicted yet, exceed the memory limit
+    while (!m_packer.insert(width + 2 * padding, height + 2 * padding, rect))
+    {
+        if (!grow() && !evict() && !grow(true))
+            return false;
+    }
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    rect.left += padding;
+    rect.top += padding;
+    rect.width -= 2 * padding;
+    rect.height -= 2 * padding;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::allocate(const std::vector<Vector2u>& sizes, std::vector<IntRect>& rects, IntRect& block)
+{
+    if (sizes.empty())
+        return false;
+
+    // Choose the width of the block so that it's roughly square
+    unsigned int maximumSize = Texture::getMaximumSize();
+    unsigned int widest = 0;
+    Uint64 area = 0;
+    for (std::vector<Vector2u>::const_iterator it = sizes.begin(); it != sizes.end(); ++it)
+    {
+        widest = std::max(widest, it->x + 2 * padding);
+        area += static_cast<Uint64>(it->x + 2 * padding) * (it->y + 2 * padding);
+    }
+    unsigned int width = static_cast<unsigned int>(std::sqrt(static_cast<double>(area)) * 1.1);
+    width = std::min(std::max(width, widest), maximumSize);
+
+    // Pack the glyphs, padding included, inside the block
+    SkylinePacker packer;
+    packer.reset(width, maximumSize);
+    rects.resize(sizes.size());
+    unsigned int height = 0;
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        if (!packer.insert(sizes[i].x + 2 * padding, sizes[i].y + 2 * padding, rects[i]))
+            return false;
+
+        height = std::max(height, static_cast<unsigned int>(rects[i].top + rects[i].height));
+    }
+
+    // Place the block in the texture, enlarging it if needed
+    while (!m_packer.insert(width, height, block))
+    {
+        if (!grow())
+            return false;
+    }
+
+    // Move the glyphs to their final position, without their padding
+    for (std::vector<IntRect>::iterator it = rects.begin(); it != rects.end(); ++it)
+    {
+        it->left += block.left + padding;
+        it->top += block.top + padding;
+        it->width -= 2 * padding;
+        it->height -= 2 * padding;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& GlyphAtlas::getTexture()
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& GlyphAtlas::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphAtlas::setMemoryLimit(std::size_t bytes)
+{
+    m_memoryLimit = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphAtlas::reserve(Uint64 area)
+{
+    Vector2u size = m_texture.getSize();
+    Vector2u next = size;
+    while ((static_cast<Uint64>(size.x) * size.y < m_packer.getUsedArea() + area) && getNextSize(next))
+        size = next;
+
+    if (size != m_texture.getSize())
+        resize(size);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphAtlas::getGlyphs(std::vector<Entry>& glyphs) const
+{
+    glyphs.clear();
+    for (std::deque<Slot>::const_iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+    {
+        if (it->used)
+            glyphs.push_back(it->entry);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::restore(const Image& image, const std::vector<Entry>& glyphs)
+{
+    // Rectangles outside the texture would corrupt the packer, which could then overwrite other glyphs
+    for (std::vector<Entry>::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
+    {
+        if (!it->alias && !isValidRect(it->glyph.textureRect, image.getSize()))
+            return false;
+    }
+
+    RenderTarget::flushBatches(m_texture);
+
+    if (!m_texture.loadFromImage(image))
+        return false;
+
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_index.clear();
+    m_latinPages.clear();
+    m_clock = 0;
+    m_generation = getUniqueGeneration();
+
+    // Rebuild the packer from the rectangles of the glyphs, padding included
+    IntRect square;
+    m_packer.reset(image.getSize().x, image.getSize().y);
+    m_packer.insert(2 + padding, 2 + padding, square);
+    for (std::vector<Entry>::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
+    {
+        insert(it->key, it->glyph, it->alias);
+
+        const IntRect& rect = it->glyph.textureRect;
+        if (!it->alias && (rect.width > 0) && (rect.height > 0))
+            m_packer.occupy(IntRect(rect.left - padding, rect.top - padding, rect.width + 2 * padding, rect.height + 2 * padding));
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::isValidRect(const IntRect& rect, const Vector2u& size)
+{
+    if (rect == IntRect())
+        return true;
+
+    return (rect.width > 0) && (rect.height > 0) &&
+           (rect.left >= static_cast<int>(padding)) && (rect.top >= static_cast<int>(padding)) &&
+           (static_cast<Int64>(rect.left) + rect.width + padding <= size.x) &&
+           (static_cast<Int64>(rect.top) + rect.height + padding <= size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GlyphAtlas::getGeneration() const
+{
+    return m_generation;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GlyphAtlas::getGlyphCount() const
+{
+    return m_slots.size() - m_freeSlots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GlyphAtlas::getMemoryUsage() const
+{
+    return static_cast<std::size_t>(m_texture.getSize().x) * m_texture.getSize().y * 4;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GlyphAtlas::getEvictionCount() const
+{
+    return m_evictions;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphAtlas::setLastUse(Uint64 stamp)
+{
+    m_lastUse = stamp;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GlyphAtlas::getLastUse() const
+{
+    return m_lastUse;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::getNextSize(Vector2u& size, bool ignoreLimit) const
+{
+    unsigned int width  = size.x;
+    unsigned int height = size.y;
+
+    // Double the smallest dimension, so that the memory grows in
+    // smaller steps and the texture remains close to a square
+    if (width <= height)
+        width *= 2;
+    else
+        height *= 2;
+
+    if ((width > Texture::getMaximumSize()) || (height > Texture::getMaximumSize()))
+        return false;
+
+    if (!ignoreLimit && (m_memoryLimit > 0) && (static_cast<Uint64>(width) * height * 4 > m_memoryLimit))
+        return false;
+
+    size = Vector2u(width, height);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::resize(const Vector2u& size)
+{
+    RenderTarget::flushBatches(m_texture);
+
+    // The glyphs are copied by the graphics card, the new area is transparent white
+    if (!m_texture.resize(size.x, size.y, Color(255, 255, 255, 0)))
+        return false;
+
+    m_packer.grow(size.x, size.y);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::grow(bool ignoreLimit)
+{
+    Vector2u size = m_texture.getSize();
+
+    return getNextSize(size, ignoreLimit) && resize(size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphAtlas::evict()
+{
+    // Recorded draws may use any glyph, keep them all until the queues are submitted
+    if (DrawQueue::isRecorded(m_texture))
+        return false;
+
+    // Find the least recently used glyph; glyphs without pixels
+    // (such as spaces) take no room and are never evicted
+    std::size_t oldest = m_slots.size();
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        const Slot& slot = m_slots[i];
+        const IntRect& rect = slot.entry.glyph.textureRect;
+        if (slot.used && !slot.entry.alias && (rect.width > 0) && (rect.height > 0))
+        {
+            if ((oldest == m_slots.size()) || (slot.entry.lastUse < m_slots[oldest].entry.lastUse))
+                oldest = i;
+        }
+    }
+
+    if (oldest == m_slots.size())
+        return false;
+
+    // Remove the glyph and its aliases
+    IntRect rect = m_slots[oldest].entry.glyph.textureRect;
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].used && (m_slots[i].entry.glyph.textureRect == rect))
+            remove(static_cast<Uint32>(i));
+    }
+    m_generation = getUniqueGeneration();
+    m_evictions++;
+
+    // Give the space back to the packer, padding included
+    rect.left -= padding;
+    rect.top -= padding;
+    rect.width += 2 * padding;
+    rect.height += 2 * padding;
+    m_packer.free(rect);
+
+    // Clear the pixels, so that the padding of the next glyphs
+    // placed there is transparent; the pending batches which
+    // still sample the evicted glyph are rendered first
+    RenderTarget::flushBatches(m_texture);
+    std::vector<Uint8> pixels(rect.width * rect.height * 4, 255);
+    for (std::size_t i = 3; i < pixels.size(); i += 4)
+        pixels[i] = 0;
+    m_texture.update(&pixels[0], rect.width, rect.height, rect.left, rect.top);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+GlyphAtlas::LatinPage& GlyphAtlas::getLatinPage(const Key& key)
+{
+    Uint64 style = key.second & ~codePointMask;
+    for (std::vector<LatinPage>::iterator it = m_latinPages.begin(); it != m_latinPages.end(); ++it)
+    {
+        if ((it->characterSize == key.first) && (it->style == style))
+            return *it;
+    }
+
+    // Not found: add a new page, or replace the oldest one
+    if (m_latinPages.size() < latinPageCount)
+    {
+        m_latinPages.push_back(LatinPage());
+        m_nextPage = m_latinPages.size() - 1;
+    }
+
+    LatinPage& page = m_latinPages[m_nextPage];
+    page.characterSize = key.first;
+    page.style = style;
+    std::fill(page.slots, page.slots + 256, 0);
+
+    m_nextPage = (m_nextPage + 1) % latinPageCount;
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphAtlas::remove(Uint32 index)
+{
+    Slot& slot = m_slots[index];
+    m_index.erase(slot.entry.key);
+    slot.used = false;
+    m_freeSlots.push_back(index);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,415 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLYPHATLAS_HPP
+#define SFML_GLYPHATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FlatHashMap.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <deque>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Texture storing the rasterized glyphs of a font
+///
+/// The glyphs are placed with a skyline packer. When the
+/// texture is full, it is enlarged until it reaches either the
+/// maximum texture size or the memory limit of the atlas; past
+/// that point, the least recently used glyphs are evicted to
+/// make room for the new ones.
+///
+/// Draws that refer to the texture may still be pending, in
+/// the batch of a render target or in a draw queue. Before the
+/// texture is enlarged, rewritten or destroyed, the batches
+/// that use it are flushed (see RenderTarget::flushBatches).
+/// Glyphs are not evicted while a draw queue has recorded
+/// draws using the texture: the atlas grows past its memory
+/// limit instead, until the queue is submitted.
+///
+/// Glyphs are looked up in a flat hash table, and the Latin-1
+/// glyphs of the most recently used sizes and styles are also
+/// indexed directly by code point.
+///
+////////////////////////////////////////////////////////////
+class GlyphAtlas
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Key identifying a glyph: character size and
+    ///        combination of outline, bold flag and code point
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<unsigned int, Uint64> Key;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph stored in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Key    key;     ///< Key of the glyph
+        Glyph  glyph;   ///< Description of the glyph
+        Uint64 lastUse; ///< Value of the usage clock when the glyph was last requested
+        bool   alias;   ///< Does the glyph use the pixels of another one?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a 128x128 texture with a 2x2 white square at
+    /// its top-left corner, used to draw underlines.
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The render targets whose pending batch uses the texture
+    /// are flushed before it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look for a glyph and mark it as recently used
+    ///
+    /// \param key Key of the glyph
+    ///
+    /// \return Pointer to the glyph, or NULL if it's not in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph* find(const Key& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a glyph to the atlas
+    ///
+    /// The texture rectangle of the glyph must have been
+    /// obtained with allocate (or be empty). An alias reuses
+    /// the texture rectangle of another glyph, such as a scaled
+    /// distance field glyph; it is evicted along with it.
+    /// A glyph already stored with the same key is replaced.
+    ///
+    /// \param key   Key of the glyph
+    /// \param glyph Glyph to add
+    /// \param alias Does the glyph share its pixels with another one?
+    ///
+    /// \return Reference to the stored glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& insert(const Key& key, const Glyph& glyph, bool alias = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room in the texture for the pixels of a glyph
+    ///
+    /// A transparent padding is kept around the returned
+    /// rectangle, so that filtering doesn't pollute the glyph
+    /// with pixels from its neighbours. This function may
+    /// enlarge the texture or evict old glyphs.
+    ///
+    /// \param width  Width of the glyph, in pixels
+    /// \param height Height of the glyph, in pixels
+    /// \param rect   Receives the rectangle of the glyph in the texture
+    ///
+    /// \return True on success, false if there's no room left
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve a single block of the texture for the pixels of several glyphs
+    ///
+    /// The glyphs are packed together in a rectangular block, so
+    /// that their pixels can be written with a single texture
+    /// update. Each glyph keeps its own padding, so that it can
+    /// later be evicted on its own. The texture may be enlarged,
+    /// but no glyph is evicted: if the block doesn't fit, the
+    /// glyphs must be allocated one by one.
+    ///
+    /// \param sizes Sizes of the glyphs, in pixels (none can be empty)
+    /// \param rects Receives the rectangle of each glyph in the texture
+    /// \param block Receives the rectangle of the block in the texture
+    ///
+    /// \return True on success, false if the block doesn't fit
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(const std::vector<Vector2u>& sizes, std::vector<IntRect>& rects, IntRect& block);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture containing the glyphs
+    ///
+    /// \return Texture of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& getTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture containing the glyphs
+    ///
+    /// \return Texture of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum amount of memory used by the texture
+    ///
+    /// \param bytes Memory limit, in bytes (0 means no limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMemoryLimit(std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the texture so that it has room for a given area
+    ///
+    /// This avoids growing the texture several times when many
+    /// glyphs are about to be added. The texture is enlarged
+    /// at most up to its limits.
+    ///
+    /// \param area Number of pixels that will be needed
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(Uint64 area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs stored in the atlas
+    ///
+    /// \param glyphs Receives the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void getGlyphs(std::vector<Entry>& glyphs) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the content of the atlas
+    ///
+    /// This is used to restore an atlas saved previously: the
+    /// texture is loaded from the image, and the rectangles of
+    /// the glyphs are marked as used.
+    ///
+    /// \param image  Pixels of the texture
+    /// \param glyphs Glyphs stored in the image
+    ///
+    /// \return True on success, false if the texture can't be
+    ///         created or a glyph rectangle is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restore(const Image& image, const std::vector<Entry>& glyphs);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a glyph rectangle fits in a texture
+    ///
+    /// Glyphs without pixels have an empty rectangle. The others
+    /// must have a positive size, and lie inside the texture
+    /// with their padding around them.
+    ///
+    /// \param rect Texture rectangle of the glyph
+    /// \param size Size of the texture
+    ///
+    /// \return True if the rectangle is valid
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isValidRect(const IntRect& rect, const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the generation of the atlas
+    ///
+    /// The generation changes whenever glyphs are removed from
+    /// the atlas, which invalidates their texture rectangle.
+    /// Adding glyphs or enlarging the texture doesn't move
+    /// the existing glyphs, and keeps the generation unchanged.
+    /// Generations are unique among all the atlases.
+    ///
+    /// \return Generation of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getGeneration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of glyphs stored in the atlas
+    ///
+    /// \return Number of glyphs, aliases included
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getGlyphCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by the texture
+    ///
+    /// \return Size of the texture, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of glyphs evicted since the atlas was created
+    ///
+    /// \return Number of evicted glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getEvictionCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record when the atlas was last used
+    ///
+    /// The stamp comes from a clock of the owner, which uses it
+    /// to release the least recently used atlases.
+    ///
+    /// \param stamp Value of the owner's usage clock
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLastUse(Uint64 stamp);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get when the atlas was last used
+    ///
+    /// \return Stamp given to the last call to setLastUse
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLastUse() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage of a glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Entry entry; ///< The glyph
+        bool  used;  ///< Is the slot used, or in the free list?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Direct index of the Latin-1 glyphs of a size and style
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LatinPage
+    {
+        unsigned int characterSize; ///< Character size of the glyphs
+        Uint64       style;         ///< Key bits of the glyphs above the code point (bold, outline)
+        Uint32       slots[256];    ///< Index + 1 of the slot of each glyph (0 if unknown)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the direct index of the Latin-1 glyphs of a size and style
+    ///
+    /// A page is created if needed, replacing the oldest one.
+    ///
+    /// \param key Key of a Latin-1 glyph
+    ///
+    /// \return The page
+    ///
+    ////////////////////////////////////////////////////////////
+    LatinPage& getLatinPage(const Key& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a glyph
+    ///
+    /// \param index Index of the slot of the glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Uint32 index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the next size of the texture
+    ///
+    /// \param size        Current size, receives the next one
+    /// \param ignoreLimit Ignore the memory limit of the atlas?
+    ///
+    /// \return True if the texture can grow, false if it reached its limits
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getNextSize(Vector2u& size, bool ignoreLimit = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the texture, keeping its content
+    ///
+    /// \param size New size of the texture
+    ///
+    /// \return True if the texture was enlarged
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resize(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the texture to its next size
+    ///
+    /// \param ignoreLimit Ignore the memory limit of the atlas?
+    ///
+    /// \return True if the texture was enlarged, false if it reached its limits
+    ///
+    ////////////////////////////////////////////////////////////
+    bool grow(bool ignoreLimit = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the least recently used glyph which has pixels in the texture
+    ///
+    /// The aliases of the glyph are removed as well. Nothing is
+    /// evicted while a draw queue has recorded draws using the
+    /// texture, since they may refer to the glyph.
+    ///
+    /// \return True if a glyph was evicted, false if there's none left
+    ///         or if the glyphs can't be evicted now
+    ///
+    ////////////////////////////////////////////////////////////
+    bool evict();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Slot>         m_slots;       ///< Storage of the glyphs (a deque keeps their address stable)
+    std::vector<Uint32>      m_freeSlots;   ///< Indices of the unused slots
+    FlatHashMap<Key, Uint32> m_index;       ///< Index of the slot of each glyph
+    std::vector<LatinPage>   m_latinPages;  ///< Direct indices of the Latin-1 glyphs
+    std::size_t              m_nextPage;    ///< Latin-1 page to replace when a new one is needed
+    SkylinePacker            m_packer;      ///< Placement of the glyphs in the texture
+    Texture                  m_texture;     ///< Texture containing the pixels of the glyphs
+    std::size_t              m_memoryLimit; ///< Maximum size of the texture, in bytes (0 for no limit)
+    Uint64                   m_clock;       ///< Usage clock, incremented each time a glyph is requested
+    Uint64                   m_generation;  ///< Unique identifier of the current set of glyphs
+    Uint64                   m_evictions;   ///< Number of glyphs evicted so far
+    Uint64                   m_lastUse;     ///< Value of the owner's usage clock when the atlas was last used
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHATLAS_HPP
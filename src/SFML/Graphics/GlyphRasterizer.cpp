@@ -0,0 +1,461 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_OUTLINE_H
+#include FT_BITMAP_H
+#include FT_STROKER_H
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // One-dimensional squared distance transform (Felzenszwalb and Huttenlocher),
+    // applied in place on count values separated by stride
+    void distanceTransform(float* values, int count, int stride, std::vector<float>& f, std::vector<int>& v, std::vector<float>& z)
+    {
+        for (int q = 0; q < count; ++q)
+            f[q] = values[q * stride];
+
+        // Lower envelope of the parabolas rooted at each value
+        int k = 0;
+        v[0] = 0;
+        z[0] = -1e20f;
+        z[1] = 1e20f;
+        for (int q = 1; q < count; ++q)
+        {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            while (s <= z[k])
+            {
+                --k;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = 1e20f;
+        }
+
+        // Evaluate the envelope
+        k = 0;
+        for (int q = 0; q < count; ++q)
+        {
+            while (z[k + 1] < q)
+                ++k;
+            values[q * stride] = (q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    }
+
+    // Replace the values of a grid (0 for seeds, 1e20 elsewhere)
+    // by the squared distance to the nearest seed
+    void distanceTransform(std::vector<float>& grid, int width, int height)
+    {
+        int size = std::max(width, height);
+        std::vector<float> f(size);
+        std::vector<int> v(size);
+        std::vector<float> z(size + 1);
+
+        for (int x = 0; x < width; ++x)
+            distanceTransform(&grid[x], height, width, f, v, z);
+        for (int y = 0; y < height; ++y)
+            distanceTransform(&grid[y * width], width, 1, f, v, z);
+    }
+
+    // Convert RGBA pixels whose alpha is the coverage of a glyph to a signed distance
+    // field, with a margin of spread pixels; 0.5 is the outline, 1 is inside
+    void makeDistanceField(std::vector<sf::Uint8>& pixels, int width, int height, int spread)
+    {
+        int fieldWidth  = width + 2 * spread;
+        int fieldHeight = height + 2 * spread;
+
+        // Seed the distance to the inside and outside of the glyph
+        std::vector<sf::Uint8> coverage(fieldWidth * fieldHeight, 0);
+        std::vector<float> toInside(fieldWidth * fieldHeight, 1e20f);
+        std::vector<float> toOutside(fieldWidth * fieldHeight, 0.f);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                std::size_t index = (x + spread) + (y + spread) * fieldWidth;
+                coverage[index] = pixels[(x + y * width) * 4 + 3];
+                if (coverage[index] >= 128)
+                {
+                    toInside[index] = 0.f;
+                    toOutside[index] = 1e20f;
+                }
+            }
+        }
+        distanceTransform(toInside, fieldWidth, fieldHeight);
+        distanceTransform(toOutside, fieldWidth, fieldHeight);
+
+        pixels.assign(fieldWidth * fieldHeight * 4, 255);
+        for (std::size_t i = 0; i < coverage.size(); ++i)
+        {
+            // Signed distance to the outline, in pixels (negative inside); the outline
+            // lies between pixel centers, or inside the partially covered pixels
+            float distance;
+            if ((coverage[i] > 0) && (coverage[i] < 255))
+                distance = 0.5f - coverage[i] / 255.f;
+            else if (coverage[i] >= 128)
+                distance = 0.5f - std::sqrt(toOutside[i]);
+            else
+                distance = std::sqrt(toInside[i]) - 0.5f;
+
+            float value = 0.5f - distance / (2 * spread);
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(std::min(std::max(value, 0.f), 1.f) * 255.f + 0.5f);
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphRasterizer::GlyphRasterizer(const std::string& filename, const void* data, std::size_t size, unsigned int characterSize, int spread) :
+m_filename     (filename),
+m_data         (data),
+m_size         (size),
+m_copy         (),
+m_characterSize(characterSize),
+m_spread       (spread),
+m_jobs         (),
+m_threads      (),
+m_mutex        (),
+m_next         (0),
+m_done         (0),
+m_running      (0),
+m_cancelled    (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::~GlyphRasterizer()
+{
+    cancel();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::adoptData(std::vector<char>& data)
+{
+    m_copy.swap(data);
+    m_data = m_copy.empty() ? NULL : &m_copy[0];
+    m_size = m_copy.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::add(Uint32 codePoint, bool bold, float outlineThickness)
+{
+    Job job;
+    job.codePoint        = codePoint;
+    job.bold             = bold;
+    job.outlineThickness = outlineThickness;
+    job.width            = 0;
+    job.height           = 0;
+    job.done             = false;
+
+    m_jobs.push_back(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::launch(unsigned int threadCount)
+{
+    // There's no point in having more workers than glyphs
+    threadCount = std::max(1u, std::min(threadCount, static_cast<unsigned int>(m_jobs.size())));
+
+    m_running = threadCount;
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        m_threads.push_back(new Thread(&GlyphRasterizer::run, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::isDone() const
+{
+    Lock lock(m_mutex);
+
+    return m_running == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+float GlyphRasterizer::getProgress() const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs.empty() ? 1.f : static_cast<float>(m_done) / m_jobs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::wait()
+{
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_threads.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::cancel()
+{
+    {
+        Lock lock(m_mutex);
+        m_cancelled = true;
+    }
+
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlyphRasterizer::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+int GlyphRasterizer::getSpread() const
+{
+    return m_spread;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<GlyphRasterizer::Job>& GlyphRasterizer::getJobs()
+{
+    return m_jobs;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::rasterize(void* library, void* face, void* stroker, int spread, Uint32 codePoint, bool bold, float outlineThickness,
+                                Glyph& glyph, std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height)
+{
+    FT_Face ftFace = static_cast<FT_Face>(face);
+
+    glyph = Glyph();
+    width = 0;
+    height = 0;
+
+    // Load the glyph corresponding to the code point
+    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
+    if (outlineThickness != 0)
+        flags |= FT_LOAD_NO_BITMAP;
+    if (FT_Load_Char(ftFace, codePoint, flags) != 0)
+        return false;
+
+    // Retrieve the glyph
+    FT_Glyph glyphDesc;
+    if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0)
+        return false;
+
+    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+    FT_Pos weight = 1 << 6;
+    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+    if (outline)
+    {
+        if (bold)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        if (outlineThickness != 0)
+        {
+            FT_Stroker ftStroker = static_cast<FT_Stroker>(stroker);
+
+            FT_Stroker_Set(ftStroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+            FT_Glyph_Stroke(&glyphDesc, ftStroker, false);
+        }
+    }
+
+    // Convert the glyph to a bitmap (i.e. rasterize it)
+    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+    if (!outline)
+    {
+        if (bold)
+            FT_Bitmap_Embolden(static_cast<FT_Library>(library), &bitmap, weight, weight);
+
+        if (outlineThickness != 0)
+            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+    }
+
+    // Compute the glyph's advance offset
+    glyph.advance = static_cast<float>(ftFace->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    if (bold)
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+    int bitmapWidth  = bitmap.width;
+    int bitmapHeight = bitmap.rows;
+
+    if ((bitmapWidth > 0) && (bitmapHeight > 0))
+    {
+        // Compute the glyph's bounding box
+        glyph.bounds.left   =  static_cast<float>(ftFace->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+        glyph.bounds.top    = -static_cast<float>(ftFace->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+        glyph.bounds.width  =  static_cast<float>(ftFace->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+        glyph.bounds.height =  static_cast<float>(ftFace->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+
+        // Extract the glyph's pixels from the bitmap
+        pixels.assign(bitmapWidth * bitmapHeight * 4, 255);
+        const Uint8* source = bitmap.buffer;
+        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Pixels are 1 bit monochrome values
+            for (int y = 0; y < bitmapHeight; ++y)
+            {
+                for (int x = 0; x < bitmapWidth; ++x)
+                {
+                    // The color channels remain white, just fill the alpha channel
+                    std::size_t index = (x + y * bitmapWidth) * 4 + 3;
+                    pixels[index] = ((source[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+                }
+                source += bitmap.pitch;
+            }
+        }
+        else
+        {
+            // Pixels are 8 bits gray levels
+            for (int y = 0; y < bitmapHeight; ++y)
+            {
+                for (int x = 0; x < bitmapWidth; ++x)
+                {
+                    // The color channels remain white, just fill the alpha channel
+                    std::size_t index = (x + y * bitmapWidth) * 4 + 3;
+                    pixels[index] = source[x];
+                }
+                source += bitmap.pitch;
+            }
+        }
+
+        // Replace the coverage by the distance to the outline, stored in a margin around the glyph
+        if (spread > 0)
+        {
+            makeDistanceField(pixels, bitmapWidth, bitmapHeight, spread);
+
+            bitmapWidth  += 2 * spread;
+            bitmapHeight += 2 * spread;
+            glyph.bounds.left   -= spread;
+            glyph.bounds.top    -= spread;
+            glyph.bounds.width  += 2 * spread;
+            glyph.bounds.height += 2 * spread;
+        }
+
+        width  = bitmapWidth;
+        height = bitmapHeight;
+    }
+
+    // Delete the FT glyph
+    FT_Done_Glyph(glyphDesc);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::run()
+{
+    // Open a face of our own, as faces can't be shared between threads
+    FT_Library library = NULL;
+    FT_Face    face    = NULL;
+    FT_Stroker stroker = NULL;
+    bool       ready   = false;
+    if (FT_Init_FreeType(&library) == 0)
+    {
+        FT_Error error;
+        if (!m_filename.empty())
+            error = FT_New_Face(library, m_filename.c_str(), 0, &face);
+        else
+            error = FT_New_Memory_Face(library, static_cast<const FT_Byte*>(m_data), static_cast<FT_Long>(m_size), 0, &face);
+
+        ready = (error == 0) &&
+                (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) &&
+                (FT_Set_Pixel_Sizes(face, 0, m_characterSize) == 0) &&
+                (FT_Stroker_New(library, &stroker) == 0);
+    }
+
+    if (!ready)
+        err() << "Failed to rasterize glyphs in a worker thread (failed to create the font face)" << std::endl;
+
+    // Rasterize the glyphs until there's none left
+    while (ready)
+    {
+        std::size_t index;
+        {
+            Lock lock(m_mutex);
+            if (m_cancelled || (m_next == m_jobs.size()))
+                break;
+            index = m_next++;
+        }
+
+        Job& job = m_jobs[index];
+        job.done = rasterize(library, face, stroker, m_spread, job.codePoint, job.bold, job.outlineThickness,
+                             job.glyph, job.pixels, job.width, job.height);
+
+        Lock lock(m_mutex);
+        m_done++;
+    }
+
+    // Close our face
+    if (stroker)
+        FT_Stroker_Done(stroker);
+    if (face)
+        FT_Done_Face(face);
+    if (library)
+        FT_Done_FreeType(library);
+
+    Lock lock(m_mutex);
+    m_running--;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLYPHRASTERIZER_HPP
+#define SFML_GLYPHRASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Rasterizer of glyph batches on worker threads
+///
+/// A FreeType face can't be used by several threads at once,
+/// so each worker opens its own face on the font data, and
+/// takes the next glyph of the batch until none is left.
+/// The workers only produce pixels: adding them to the glyph
+/// atlas is left to the thread that owns the font.
+///
+////////////////////////////////////////////////////////////
+class GlyphRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph to rasterize, and result of the rasterization
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        Uint32             codePoint;        ///< Unicode code point of the character
+        bool               bold;             ///< Rasterize the bold version?
+        float              outlineThickness; ///< Thickness of the outline (when != 0 the glyph is not filled)
+        Glyph              glyph;            ///< Metrics of the glyph (its texture rectangle is left empty)
+        std::vector<Uint8> pixels;           ///< RGBA pixels of the glyph
+        unsigned int       width;            ///< Width of the pixels
+        unsigned int       height;           ///< Height of the pixels
+        bool               done;             ///< Was the glyph rasterized?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The font data is read from a file if \a filename is not
+    /// empty, otherwise from memory. The memory must remain
+    /// valid until the workers are done.
+    ///
+    /// \param filename      Path of the font file
+    /// \param data          Pointer to the font data in memory
+    /// \param size          Size of the font data, in bytes
+    /// \param characterSize Character size of all the glyphs
+    /// \param spread        Margin of the distance fields, or 0 to rasterize coverage
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphRasterizer(const std::string& filename, const void* data, std::size_t size, unsigned int characterSize, int spread);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The workers are stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep a copy of the font data
+    ///
+    /// This is used for fonts read from a stream, which can't
+    /// be shared with the workers.
+    ///
+    /// \param data Font data, swapped with the internal copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void adoptData(std::vector<char>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a glyph to the batch
+    ///
+    /// Glyphs must be added before the workers are launched.
+    ///
+    /// \param codePoint        Unicode code point of the character
+    /// \param bold             Rasterize the bold version?
+    /// \param outlineThickness Thickness of the outline
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(Uint32 codePoint, bool bold, float outlineThickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start rasterizing the glyphs
+    ///
+    /// \param threadCount Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(unsigned int threadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the workers are done
+    ///
+    /// \return True if wait() would not block
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDone() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of the glyphs that were rasterized
+    ///
+    /// \return Progress, between 0 and 1
+    ///
+    ////////////////////////////////////////////////////////////
+    float getProgress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the workers are done
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the workers as soon as possible
+    ///
+    /// The glyphs being rasterized are finished, the others
+    /// are skipped. This function waits for the workers.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size of the glyphs
+    ///
+    /// \return Character size
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the margin of the distance fields
+    ///
+    /// \return Margin of the distance fields, or 0 if the glyphs store coverage
+    ///
+    ////////////////////////////////////////////////////////////
+    int getSpread() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs of the batch
+    ///
+    /// The results must only be read once the workers are done.
+    ///
+    /// \return Glyphs of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Job>& getJobs();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with a FreeType face
+    ///
+    /// The character size must already be set on the face.
+    /// The pixels are white, with the coverage (or the
+    /// distance to the outline, if \a spread is not 0) in the
+    /// alpha channel; the bounds of distance field glyphs
+    /// include the margin.
+    ///
+    /// \param library          FreeType library (FT_Library)
+    /// \param face             FreeType face (FT_Face)
+    /// \param stroker          FreeType stroker (FT_Stroker)
+    /// \param spread           Margin of the distance field, or 0 to rasterize coverage
+    /// \param codePoint        Unicode code point of the character
+    /// \param bold             Rasterize the bold version?
+    /// \param outlineThickness Thickness of the outline
+    /// \param glyph            Receives the metrics of the glyph
+    /// \param pixels           Receives the pixels of the glyph
+    /// \param width            Receives the width of the pixels
+    /// \param height           Receives the height of the pixels
+    ///
+    /// \return True on success, false if the glyph can't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool rasterize(void* library, void* face, void* stroker, int spread, Uint32 codePoint, bool bold, float outlineThickness,
+                          Glyph& glyph, std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string          m_filename;      ///< Path of the font file (empty if in memory)
+    const void*          m_data;          ///< Font data in memory
+    std::size_t          m_size;          ///< Size of the font data, in bytes
+    std::vector<char>    m_copy;          ///< Copy of the font data, when it can't be shared
+    unsigned int         m_characterSize; ///< Character size of the glyphs
+    int                  m_spread;        ///< Margin of the distance fields (0 for coverage)
+    std::vector<Job>     m_jobs;          ///< Glyphs of the batch
+    std::vector<Thread*> m_threads;       ///< Worker threads
+    mutable Mutex        m_mutex;         ///< Mutex protecting the progress of the workers
+    std::size_t          m_next;          ///< Index of the next glyph to rasterize
+    std::size_t          m_done;          ///< Number of glyphs processed
+    unsigned int         m_running;       ///< Number of workers still running
+    bool                 m_cancelled;     ///< Must the workers stop?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHRASTERIZER_HPP
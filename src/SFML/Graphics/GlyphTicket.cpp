@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphTicket.hpp>
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/Graphics/Font.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GlyphTicket::GlyphTicket() :
+m_font      (NULL),
+m_rasterizer(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTicket::~GlyphTicket()
+{
+    cancel();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphTicket::isPending() const
+{
+    return m_rasterizer != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphTicket::isReady() const
+{
+    return m_rasterizer && m_rasterizer->isDone();
+}
+
+
+////////////////////////////////////////////////////////////
+float GlyphTicket::getProgress() const
+{
+    return m_rasterizer ? m_rasterizer->getProgress() : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphTicket::wait()
+{
+    if (!m_rasterizer)
+        return false;
+
+    // Wait for the workers, then add their glyphs to the font
+    m_rasterizer->wait();
+    m_font->addRasterizedGlyphs(*m_rasterizer);
+    m_font->removeTicket(this);
+
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+    m_font = NULL;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphTicket::cancel()
+{
+    if (m_font)
+        m_font->removeTicket(this);
+
+    // Destroying the rasterizer stops its workers
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+    m_font = NULL;
+}
+
+} // namespace sf
@@ -27,14 +27,40 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageFilters.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/SaveTicket.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
+namespace
+{
+    // Conversions of a color component between the sRGB and linear color spaces, in the [0, 1] range
+    float srgbToLinear(float value)
+    {
+        return (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linearToSrgb(float value)
+    {
+        return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+    }
+
+    // Build the table mapping each 8-bit component to its converted value
+    void buildConversionTable(float (*conversion)(float), sf::Uint8* table)
+    {
+        for (int i = 0; i < 256; ++i)
+            table[i] = static_cast<sf::Uint8>(conversion(i / 255.f) * 255.f + 0.5f);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -126,6 +152,14 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::reserve(unsigned int width, unsigned int height)
+{
+    // One spare byte is kept for the image decoder (see ImageLoader)
+    m_pixels.reserve(static_cast<std::size_t>(width) * height * 4 + 1);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::loadFromFile(const std::string& filename)
 {
@@ -166,6 +200,36 @@ bool Image::saveToFile(const std::string& filename) const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(output, format, m_pixels, m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToStream(OutputStream& stream, const std::string& format) const
+{
+    return priv::ImageLoader::getInstance().saveImageToStream(stream, format, m_pixels, m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToFileAsync(SaveTicket& ticket, const std::string& filename) const
+{
+    // Make sure that the image is not empty
+    if (m_pixels.empty())
+    {
+        err() << "Failed to save image \"" << filename << "\" (the image is empty)" << std::endl;
+        return false;
+    }
+
+    ticket.launch(filename, m_pixels, m_size);
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Image::getSize() const
 {
@@ -180,14 +244,8 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        priv::maskPixels(&m_pixels[0], m_pixels.size() / 4, components, alpha);
     }
 }
 
@@ -237,23 +295,10 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            priv::blendPixels(srcPixels, dstPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -313,18 +358,7 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            priv::reversePixels(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -336,12 +370,12 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            priv::swapBytes(top, bottom, rowSize);
 
             top += rowSize;
             bottom -= rowSize;
@@ -349,4 +383,73 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResamplingFilter filter, unsigned int threadCount)
+{
+    // Nothing to resample
+    if (m_pixels.empty() || ((width == m_size.x) && (height == m_size.y)))
+        return;
+
+    if ((width == 0) || (height == 0))
+    {
+        create(width, height);
+        return;
+    }
+
+    std::vector<Uint8> pixels(width * height * 4);
+    priv::resizePixels(&m_pixels[0], m_size, &pixels[0], Vector2u(width, height), filter, threadCount);
+
+    m_pixels.swap(pixels);
+    m_size = Vector2u(width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blur(float sigma, unsigned int threadCount)
+{
+    if (!m_pixels.empty() && (sigma > 0.f))
+        priv::blurPixels(&m_pixels[0], m_size, sigma, threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::premultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::unpremultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convertSrgbToLinear()
+{
+    if (!m_pixels.empty())
+    {
+        Uint8 table[256];
+        buildConversionTable(&srgbToLinear, table);
+        priv::mapColorComponents(&m_pixels[0], m_pixels.size() / 4, table);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convertLinearToSrgb()
+{
+    if (!m_pixels.empty())
+    {
+        Uint8 table[256];
+        buildConversionTable(&linearToSrgb, table);
+        priv::mapColorComponents(&m_pixels[0], m_pixels.size() / 4, table);
+    }
+}
+
 } // namespace sf
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageBatchLoader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct ImageBatchLoader::Job
+{
+    std::string  filename; ///< Path of the image file (empty if in memory or in a stream)
+    const void*  data;     ///< Image file in memory
+    std::size_t  size;     ///< Size of the image file in memory, in bytes
+    InputStream* stream;   ///< Stream to read the image file from
+    Image        image;    ///< Loaded image
+    Texture      texture;  ///< Texture of the image, if requested
+    Status       status;   ///< Status of the image
+    std::string  error;    ///< Reason of the failure
+    bool         reported; ///< Was the failure written to the error output?
+};
+
+
+////////////////////////////////////////////////////////////
+ImageBatchLoader::ImageBatchLoader() :
+m_jobs          (),
+m_uploads       (),
+m_threads       (),
+m_mutex         (),
+m_next          (0),
+m_finished      (0),
+m_decoding      (0),
+m_running       (0),
+m_createTextures(false),
+m_uploaderTaken (false),
+m_cancelled     (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatchLoader::~ImageBatchLoader()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::add(const std::string& filename)
+{
+    Job* job = new Job;
+    job->filename = filename;
+    job->data     = NULL;
+    job->size     = 0;
+    job->stream   = NULL;
+
+    return add(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::add(const void* data, std::size_t size)
+{
+    Job* job = new Job;
+    job->data   = data;
+    job->size   = size;
+    job->stream = NULL;
+
+    return add(job);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::add(InputStream& stream)
+{
+    Job* job = new Job;
+    job->data   = NULL;
+    job->size   = 0;
+    job->stream = &stream;
+
+    return add(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::launch(unsigned int threadCount, bool createTextures)
+{
+    // Don't interfere with the workers already running
+    if (!isReady())
+        return;
+
+    // Release the workers of the previous launch
+    wait();
+
+    // There's no point in having more workers than images
+    std::size_t pending = m_jobs.size() - m_finished;
+    if (pending == 0)
+        return;
+    threadCount = std::max(1u, static_cast<unsigned int>(std::min<std::size_t>(threadCount, pending)));
+
+    // Images decoded but not uploaded by the previous launch are decoded again
+    m_uploads.clear();
+
+    m_next           = 0;
+    m_decoding       = 0;
+    m_running        = threadCount;
+    m_createTextures = createTextures;
+    m_uploaderTaken  = false;
+    m_cancelled      = false;
+
+    priv::ImageLoader::prepareThreads();
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        m_threads.push_back(new Thread(&ImageBatchLoader::run, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatchLoader::isReady() const
+{
+    Lock lock(m_mutex);
+
+    return m_running == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+float ImageBatchLoader::getProgress() const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs.empty() ? 1.f : static_cast<float>(m_finished) / m_jobs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatchLoader::wait()
+{
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_threads.clear();
+
+    // Report the failures that were not reported yet
+    bool success = true;
+    for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    {
+        Job& job = **it;
+        if (job.status != Loaded)
+            success = false;
+
+        if ((job.status == Failed) && !job.reported)
+        {
+            err() << job.error << std::endl;
+            job.reported = true;
+        }
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::cancel()
+{
+    {
+        Lock lock(m_mutex);
+        m_cancelled = true;
+    }
+
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::clear()
+{
+    cancel();
+
+    for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+        delete *it;
+
+    m_jobs.clear();
+    m_uploads.clear();
+    m_finished = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::getCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatchLoader::Status ImageBatchLoader::getStatus(std::size_t index) const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs[index]->status;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string ImageBatchLoader::getError(std::size_t index) const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs[index]->error;
+}
+
+
+////////////////////////////////////////////////////////////
+Image& ImageBatchLoader::getImage(std::size_t index)
+{
+    Lock lock(m_mutex);
+
+    return m_jobs[index]->image;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& ImageBatchLoader::getTexture(std::size_t index)
+{
+    Lock lock(m_mutex);
+
+    return m_jobs[index]->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::add(Job* job)
+{
+    job->status   = Pending;
+    job->reported = false;
+
+    // The workers may be looking at the jobs
+    Lock lock(m_mutex);
+
+    m_jobs.push_back(job);
+
+    return m_jobs.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::run()
+{
+    // The first worker uploads the textures, with an OpenGL context of its own
+    Context* context = NULL;
+    {
+        Lock lock(m_mutex);
+        if (m_createTextures && !m_uploaderTaken)
+        {
+            m_uploaderTaken = true;
+            context = new Context;
+        }
+    }
+
+    for (;;)
+    {
+        // Take the next thing to do: uploading a decoded image first, then decoding a pending one
+        Job* upload = NULL;
+        Job* decode = NULL;
+        {
+            Lock lock(m_mutex);
+            if (m_cancelled)
+                break;
+
+            if (context && !m_uploads.empty())
+            {
+                upload = m_uploads.back();
+                m_uploads.pop_back();
+            }
+            else
+            {
+                while ((m_next < m_jobs.size()) && (m_jobs[m_next]->status != Pending))
+                    m_next++;
+
+                if (m_next < m_jobs.size())
+                {
+                    decode = m_jobs[m_next++];
+                    m_decoding++;
+                }
+                else if (!context || (m_decoding == 0))
+                {
+                    // Nothing left to decode, nor to upload
+                    break;
+                }
+            }
+        }
+
+        if (upload)
+        {
+            // Create the texture of the decoded image
+            bool created = upload->texture.loadFromImage(upload->image);
+
+            Lock lock(m_mutex);
+            upload->status = created ? Loaded : Failed;
+            if (!created)
+                upload->error = "Failed to create the texture of a loaded image";
+            m_finished++;
+        }
+        else if (decode)
+        {
+            // Decode the image in place, keeping the error message for the caller
+            std::string error;
+            Image& image = decode->image;
+            bool decoded;
+            if (decode->stream)
+            {
+                decoded = priv::ImageLoader::getInstance().loadImageFromStream(*decode->stream, image.m_pixels, image.m_size, &error);
+            }
+            else if (decode->filename.empty())
+            {
+                decoded = priv::ImageLoader::getInstance().loadImageFromMemory(decode->data, decode->size, image.m_pixels, image.m_size, &error);
+            }
+            else
+            {
+                #ifndef SFML_SYSTEM_ANDROID
+
+                    decoded = priv::ImageLoader::getInstance().loadImageFromFile(decode->filename, image.m_pixels, image.m_size, &error);
+
+                #else
+
+                    priv::ResourceStream stream(decode->filename);
+                    decoded = priv::ImageLoader::getInstance().loadImageFromStream(stream, image.m_pixels, image.m_size, &error);
+
+                #endif
+            }
+
+            Lock lock(m_mutex);
+            m_decoding--;
+            if (decoded && m_createTextures)
+            {
+                // Leave the texture to the uploader
+                m_uploads.push_back(decode);
+            }
+            else
+            {
+                decode->status = decoded ? Loaded : Failed;
+                decode->error  = error;
+                m_finished++;
+            }
+        }
+        else
+        {
+            // The uploader waits for the images still being decoded
+            sleep(milliseconds(1));
+        }
+    }
+
+    delete context;
+
+    Lock lock(m_mutex);
+    m_running--;
+}
+
+} // namespace sf
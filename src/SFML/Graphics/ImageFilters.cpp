@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageFilters.hpp>
+#include <SFML/Graphics/Simd.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Pixels are filtered as 4 floats (RGBA) with premultiplied alpha, which fit in a single vector
+#if defined(SFML_SIMD_SSE2)
+
+    typedef __m128 Pixel;
+
+    inline Pixel zeroPixel()
+    {
+        return _mm_setzero_ps();
+    }
+
+    inline Pixel loadPixel(const float* components)
+    {
+        return _mm_loadu_ps(components);
+    }
+
+    inline void storePixel(float* components, Pixel pixel)
+    {
+        _mm_storeu_ps(components, pixel);
+    }
+
+    inline Pixel multiplyAdd(Pixel sum, Pixel pixel, float weight)
+    {
+        return _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(weight)));
+    }
+
+    // Convert a pixel to floats, premultiplying its color components by its alpha
+    inline Pixel loadPremultiplied(const sf::Uint8* components)
+    {
+        int value;
+        std::memcpy(&value, components, 4);
+
+        const __m128i zero = _mm_setzero_si128();
+        Pixel pixel = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero));
+
+        // The alpha component is multiplied by 1
+        Pixel alpha  = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        Pixel factor = _mm_add_ps(_mm_mul_ps(alpha, _mm_setr_ps(1.f / 255.f, 1.f / 255.f, 1.f / 255.f, 0.f)), _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+
+        return _mm_mul_ps(pixel, factor);
+    }
+
+    // Convert a premultiplied pixel back to bytes, with straight alpha
+    inline void storeUnpremultiplied(sf::Uint8* components, Pixel pixel)
+    {
+        const Pixel zero    = _mm_setzero_ps();
+        const Pixel maximum = _mm_set1_ps(255.f);
+
+        // Filters with negative lobes may produce values out of range
+        pixel = _mm_min_ps(_mm_max_ps(pixel, zero), maximum);
+
+        // Divide the color components by the alpha (transparent pixels become black), keep the alpha component
+        Pixel alpha  = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        Pixel factor = _mm_and_ps(_mm_cmpgt_ps(alpha, zero), _mm_div_ps(maximum, alpha));
+        factor = _mm_or_ps(_mm_and_ps(factor, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))), _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+        pixel  = _mm_min_ps(_mm_mul_ps(pixel, factor), maximum);
+
+        __m128i value = _mm_cvttps_epi32(_mm_add_ps(pixel, _mm_set1_ps(0.5f)));
+        value = _mm_packs_epi32(value, value);
+        value = _mm_packus_epi16(value, value);
+
+        int bytes = _mm_cvtsi128_si32(value);
+        std::memcpy(components, &bytes, 4);
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    typedef float32x4_t Pixel;
+
+    inline Pixel zeroPixel()
+    {
+        return vdupq_n_f32(0.f);
+    }
+
+    inline Pixel loadPixel(const float* components)
+    {
+        return vld1q_f32(components);
+    }
+
+    inline void storePixel(float* components, Pixel pixel)
+    {
+        vst1q_f32(components, pixel);
+    }
+
+    inline Pixel multiplyAdd(Pixel sum, Pixel pixel, float weight)
+    {
+        return vmlaq_n_f32(sum, pixel, weight);
+    }
+
+    // Convert a pixel to floats, premultiplying its color components by its alpha
+    inline Pixel loadPremultiplied(const sf::Uint8* components)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, components, 4);
+
+        uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(value));
+        Pixel pixel = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(bytes))));
+
+        // The alpha component is multiplied by 1
+        Pixel factor = vsetq_lane_f32(1.f, vdupq_n_f32(vgetq_lane_f32(pixel, 3) / 255.f), 3);
+
+        return vmulq_f32(pixel, factor);
+    }
+
+    // Convert a premultiplied pixel back to bytes, with straight alpha
+    inline void storeUnpremultiplied(sf::Uint8* components, Pixel pixel)
+    {
+        const Pixel maximum = vdupq_n_f32(255.f);
+
+        // Filters with negative lobes may produce values out of range
+        pixel = vminq_f32(vmaxq_f32(pixel, vdupq_n_f32(0.f)), maximum);
+
+        // Divide the color components by the alpha (transparent pixels become black), keep the alpha component
+        float alpha = vgetq_lane_f32(pixel, 3);
+        Pixel factor = vsetq_lane_f32(1.f, vdupq_n_f32((alpha > 0.f) ? 255.f / alpha : 0.f), 3);
+        pixel = vminq_f32(vmulq_f32(pixel, factor), maximum);
+
+        uint16x4_t value = vmovn_u32(vcvtq_u32_f32(vaddq_f32(pixel, vdupq_n_f32(0.5f))));
+        uint8x8_t  bytes = vmovn_u16(vcombine_u16(value, value));
+
+        sf::Uint32 result = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+        std::memcpy(components, &result, 4);
+    }
+
+#else
+
+    struct Pixel
+    {
+        float components[4];
+    };
+
+    inline Pixel zeroPixel()
+    {
+        Pixel pixel = {{0.f, 0.f, 0.f, 0.f}};
+        return pixel;
+    }
+
+    inline Pixel loadPixel(const float* components)
+    {
+        Pixel pixel = {{components[0], components[1], components[2], components[3]}};
+        return pixel;
+    }
+
+    inline void storePixel(float* components, Pixel pixel)
+    {
+        for (int i = 0; i < 4; ++i)
+            components[i] = pixel.components[i];
+    }
+
+    inline Pixel multiplyAdd(Pixel sum, Pixel pixel, float weight)
+    {
+        for (int i = 0; i < 4; ++i)
+            sum.components[i] += pixel.components[i] * weight;
+        return sum;
+    }
+
+    // Convert a pixel to floats, premultiplying its color components by its alpha
+    inline Pixel loadPremultiplied(const sf::Uint8* components)
+    {
+        float alpha = components[3] / 255.f;
+        Pixel pixel = {{components[0] * alpha, components[1] * alpha, components[2] * alpha, static_cast<float>(components[3])}};
+        return pixel;
+    }
+
+    // Convert a premultiplied pixel back to bytes, with straight alpha
+    inline void storeUnpremultiplied(sf::Uint8* components, Pixel pixel)
+    {
+        // Filters with negative lobes may produce values out of range
+        for (int i = 0; i < 4; ++i)
+            pixel.components[i] = std::min(std::max(pixel.components[i], 0.f), 255.f);
+
+        // Divide the color components by the alpha (transparent pixels become black), keep the alpha component
+        float alpha = pixel.components[3];
+        float factor = (alpha > 0.f) ? 255.f / alpha : 0.f;
+        for (int i = 0; i < 3; ++i)
+            pixel.components[i] = std::min(pixel.components[i] * factor, 255.f);
+
+        for (int i = 0; i < 4; ++i)
+            components[i] = static_cast<sf::Uint8>(pixel.components[i] + 0.5f);
+    }
+
+#endif
+
+    // Filter functions, evaluated at a distance expressed in source pixels
+    float boxFilter(float x, float)
+    {
+        return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+    }
+
+    float triangleFilter(float x, float)
+    {
+        x = std::fabs(x);
+        return (x < 1.f) ? 1.f - x : 0.f;
+    }
+
+    float sinc(float x)
+    {
+        if (x == 0.f)
+            return 1.f;
+
+        x *= 3.141592654f;
+        return std::sin(x) / x;
+    }
+
+    float lanczosFilter(float x, float)
+    {
+        return (std::fabs(x) < 3.f) ? sinc(x) * sinc(x / 3.f) : 0.f;
+    }
+
+    float gaussianFilter(float x, float sigma)
+    {
+        return std::exp(-(x * x) / (2.f * sigma * sigma));
+    }
+
+    // Filter function along with the distance beyond which it is zero
+    struct Kernel
+    {
+        float (*function)(float x, float parameter);
+        float support;
+        float parameter;
+    };
+
+    // Weights of the source pixels contributing to each destination pixel, along one axis
+    struct Contributions
+    {
+        std::vector<unsigned int> first;   // First source pixel of each destination pixel
+        std::vector<unsigned int> count;   // Number of source pixels of each destination pixel
+        std::vector<std::size_t>  offset;  // Index of the first weight of each destination pixel
+        std::vector<float>        weights; // Weights of the source pixels, normalized
+    };
+
+    void computeContributions(unsigned int sourceSize, unsigned int size, const Kernel& kernel, Contributions& contributions)
+    {
+        // The filter is widened when shrinking, so that all the source pixels contribute
+        float scale       = static_cast<float>(size) / sourceSize;
+        float filterScale = (scale < 1.f) ? 1.f / scale : 1.f;
+        float support     = kernel.support * filterScale;
+        int   last        = static_cast<int>(sourceSize) - 1;
+
+        contributions.first.resize(size);
+        contributions.count.resize(size);
+        contributions.offset.resize(size);
+        contributions.weights.clear();
+
+        std::vector<float> weights;
+        for (unsigned int x = 0; x < size; ++x)
+        {
+            // Center of the destination pixel, in source coordinates
+            float center = (x + 0.5f) / scale;
+            int   left   = static_cast<int>(std::floor(center - support));
+            int   right  = static_cast<int>(std::ceil(center + support));
+            int   begin  = std::min(std::max(left, 0), last);
+            int   end    = std::max(std::min(right, last), begin);
+
+            // Pixels outside the source are replaced by the closest edge pixel
+            weights.assign(end - begin + 1, 0.f);
+            float total = 0.f;
+            for (int i = left; i <= right; ++i)
+            {
+                float weight = kernel.function((i + 0.5f - center) / filterScale, kernel.parameter);
+                weights[std::min(std::max(i, begin), end) - begin] += weight;
+                total += weight;
+            }
+
+            // Normalize the weights, so that a uniform area keeps its color
+            if (total != 0.f)
+            {
+                for (std::size_t i = 0; i < weights.size(); ++i)
+                    weights[i] /= total;
+            }
+            else
+            {
+                weights.assign(1, 1.f);
+                begin = std::min(std::max(static_cast<int>(center), 0), last);
+            }
+
+            // Skip the source pixels which don't contribute
+            std::size_t first = 0;
+            std::size_t count = weights.size();
+            while ((count > 1) && (weights[first] == 0.f))
+            {
+                ++first;
+                --count;
+            }
+            while ((count > 1) && (weights[first + count - 1] == 0.f))
+                --count;
+
+            contributions.first[x]  = begin + static_cast<unsigned int>(first);
+            contributions.count[x]  = static_cast<unsigned int>(count);
+            contributions.offset[x] = contributions.weights.size();
+            contributions.weights.insert(contributions.weights.end(), weights.begin() + first, weights.begin() + first + count);
+        }
+    }
+
+    // Resample a strip of destination rows: the source rows under the vertical filter are
+    // filtered horizontally into a window of premultiplied float rows, then combined vertically
+    struct ResamplePass
+    {
+        const sf::Uint8* const* sourceRows;
+        unsigned int            sourceWidth;
+        unsigned int            width;
+        const Contributions*    horizontal;
+        const Contributions*    vertical;
+        sf::Uint8*              destination;
+
+        void process(unsigned int begin, unsigned int end) const
+        {
+            // The window keeps the last rows filtered, each one in the slot given by its index
+            // modulo the window size; it is large enough for the rows of any destination row
+            unsigned int windowSize = 1;
+            for (unsigned int y = begin; y < end; ++y)
+                windowSize = std::max(windowSize, vertical->count[y]);
+
+            std::vector<float>        window(static_cast<std::size_t>(windowSize) * width * 4);
+            std::vector<unsigned int> windowRows(windowSize, static_cast<unsigned int>(-1));
+            std::vector<float>        sourceRow(sourceWidth * 4);
+            std::vector<float>        row(width * 4);
+
+            for (unsigned int y = begin; y < end; ++y)
+            {
+                // Accumulate whole rows, which keeps the memory accesses sequential
+                std::fill(row.begin(), row.end(), 0.f);
+                for (unsigned int i = 0; i < vertical->count[y]; ++i)
+                {
+                    unsigned int sourceY = vertical->first[y] + i;
+                    unsigned int slot    = sourceY % windowSize;
+                    float*       line    = &window[static_cast<std::size_t>(slot) * width * 4];
+                    float        weight  = vertical->weights[vertical->offset[y] + i];
+
+                    if (windowRows[slot] != sourceY)
+                    {
+                        filterRow(sourceRows[sourceY], &sourceRow[0], line);
+                        windowRows[slot] = sourceY;
+                    }
+
+                    for (unsigned int x = 0; x < width; ++x)
+                        storePixel(&row[x * 4], multiplyAdd(loadPixel(&row[x * 4]), loadPixel(line + x * 4), weight));
+                }
+
+                sf::Uint8* result = destination + static_cast<std::size_t>(y) * width * 4;
+                for (unsigned int x = 0; x < width; ++x)
+                    storeUnpremultiplied(result + x * 4, loadPixel(&row[x * 4]));
+            }
+        }
+
+        void filterRow(const sf::Uint8* line, float* sourceRow, float* result) const
+        {
+            // Convert the source row once, as each pixel is used by several destination pixels
+            for (unsigned int x = 0; x < sourceWidth; ++x)
+                storePixel(sourceRow + x * 4, loadPremultiplied(line + x * 4));
+
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                const float* pixels  = sourceRow + horizontal->first[x] * 4;
+                const float* weights = &horizontal->weights[horizontal->offset[x]];
+
+                Pixel sum = zeroPixel();
+                for (unsigned int i = 0; i < horizontal->count[x]; ++i)
+                    sum = multiplyAdd(sum, loadPixel(pixels + i * 4), weights[i]);
+
+                storePixel(result + x * 4, sum);
+            }
+        }
+    };
+
+    // Range of rows processed by a thread
+    template <typename T>
+    struct Strip
+    {
+        const T*     task;
+        unsigned int begin;
+        unsigned int end;
+
+        void run()
+        {
+            task->process(begin, end);
+        }
+    };
+
+    // Split rows in strips for several threads; strip i covers the rows from bounds[i] to bounds[i + 1]
+    void splitInStrips(unsigned int rows, unsigned int threadCount, std::vector<unsigned int>& bounds)
+    {
+        // Small strips are not worth the cost of a thread
+        const unsigned int minimumRows = 32;
+        unsigned int count = std::max(1u, std::min(threadCount, rows / minimumRows));
+
+        bounds.resize(count + 1);
+        for (unsigned int i = 0; i <= count; ++i)
+            bounds[i] = static_cast<unsigned int>(static_cast<sf::Uint64>(rows) * i / count);
+    }
+
+    // Process the strips of a task, each one in its own thread
+    template <typename T>
+    void processInStrips(const T& task, const std::vector<unsigned int>& bounds)
+    {
+        std::vector<Strip<T> > strips(bounds.size() - 1);
+        for (std::size_t i = 0; i < strips.size(); ++i)
+        {
+            strips[i].task  = &task;
+            strips[i].begin = bounds[i];
+            strips[i].end   = bounds[i + 1];
+        }
+
+        // The first strip is processed by the calling thread
+        std::vector<sf::Thread*> threads;
+        for (std::size_t i = 1; i < strips.size(); ++i)
+        {
+            threads.push_back(new sf::Thread(&Strip<T>::run, &strips[i]));
+            threads.back()->launch();
+        }
+
+        strips[0].run();
+
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+    }
+
+    // Resample pixels with a separable filter, horizontally then vertically. Each thread
+    // holds a window of W * N * 16 bytes, where W is the destination width and N the number
+    // of source rows under the vertical filter (about 2 * support * max(1, source height /
+    // destination height)); no buffer of the size of the whole image is allocated
+    void resample(const sf::Uint8* source, const sf::Vector2u& sourceSize, sf::Uint8* destination, const sf::Vector2u& size, const Kernel& kernel, unsigned int threadCount)
+    {
+        Contributions horizontal;
+        Contributions vertical;
+        computeContributions(sourceSize.x, size.x, kernel, horizontal);
+        computeContributions(sourceSize.y, size.y, kernel, vertical);
+
+        std::vector<unsigned int> bounds;
+        splitInStrips(size.y, threadCount, bounds);
+
+        std::size_t stride = static_cast<std::size_t>(sourceSize.x) * 4;
+        std::vector<const sf::Uint8*> sourceRows(sourceSize.y);
+        for (unsigned int y = 0; y < sourceSize.y; ++y)
+            sourceRows[y] = source + y * stride;
+
+        // When filtering in place, the rows around the boundary of two strips are read by
+        // both but overwritten by one of them: the strips read a copy of these rows instead.
+        // Within a strip, a row is always read before it is overwritten, as the filter
+        // windows only move forward
+        std::vector<unsigned int> savedRows;
+        if (source == destination)
+        {
+            for (std::size_t i = 1; i + 1 < bounds.size(); ++i)
+            {
+                unsigned int begin = vertical.first[bounds[i]];
+                unsigned int end   = std::max(vertical.first[bounds[i] - 1] + vertical.count[bounds[i] - 1], bounds[i]);
+                for (unsigned int y = begin; y < end; ++y)
+                {
+                    if (savedRows.empty() || (savedRows.back() < y))
+                        savedRows.push_back(y);
+                }
+            }
+        }
+
+        std::vector<sf::Uint8> saved(savedRows.size() * stride);
+        for (std::size_t i = 0; i < savedRows.size(); ++i)
+        {
+            std::memcpy(&saved[i * stride], sourceRows[savedRows[i]], stride);
+            sourceRows[savedRows[i]] = &saved[i * stride];
+        }
+
+        ResamplePass pass = {&sourceRows[0], sourceSize.x, size.x, &horizontal, &vertical, destination};
+        processInStrips(pass, bounds);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void resizePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize, Image::ResamplingFilter filter, unsigned int threadCount)
+{
+    Kernel kernel;
+    kernel.parameter = 0.f;
+
+    switch (filter)
+    {
+        case Image::Box:      kernel.function = &boxFilter;      kernel.support = 0.5f; break;
+        case Image::Lanczos:  kernel.function = &lanczosFilter;  kernel.support = 3.f;  break;
+        default:              kernel.function = &triangleFilter; kernel.support = 1.f;  break;
+    }
+
+    resample(source, sourceSize, destination, destinationSize, kernel, threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void blurPixels(Uint8* pixels, const Vector2u& size, float sigma, unsigned int threadCount)
+{
+    // The gaussian is negligible beyond 3 standard deviations
+    Kernel kernel;
+    kernel.function  = &gaussianFilter;
+    kernel.support   = 3.f * sigma;
+    kernel.parameter = sigma;
+
+    resample(pixels, size, pixels, size, kernel, threadCount);
+}
+
+} // namespace priv
+
+} // namespace sf
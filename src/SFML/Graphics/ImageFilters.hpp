@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEFILTERS_HPP
+#define SFML_IMAGEFILTERS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Resample RGBA pixels to a new size
+///
+/// The source and destination arrays may be the same if
+/// both sizes are equal.
+///
+/// \param source          Source pixels
+/// \param sourceSize      Size of the source pixels
+/// \param destination     Array receiving the resampled pixels
+/// \param destinationSize Size of the resampled pixels
+/// \param filter          Filter used to compute the new pixels
+/// \param threadCount     Maximum number of threads to use
+///
+////////////////////////////////////////////////////////////
+void resizePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize, Image::ResamplingFilter filter, unsigned int threadCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Blur RGBA pixels with a gaussian filter
+///
+/// \param pixels      Pixels to blur, in place
+/// \param size        Size of the pixels
+/// \param sigma       Standard deviation of the filter, in pixels
+/// \param threadCount Maximum number of threads to use
+///
+////////////////////////////////////////////////////////////
+void blurPixels(Uint8* pixels, const Vector2u& size, float sigma, unsigned int threadCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEFILTERS_HPP
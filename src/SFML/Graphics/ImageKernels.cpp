@@ -0,0 +1,532 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/Simd.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+
+namespace
+{
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+
+    // Check whether both the CPU and the operating system (which must save the
+    // 256-bit registers on context switches) support AVX2
+    bool isAvx2Supported()
+    {
+    #if defined(_MSC_VER)
+
+        int registers[4];
+        __cpuid(registers, 0);
+        if (registers[0] < 7)
+            return false;
+
+        __cpuid(registers, 1);
+        if (!(registers[2] & (1 << 27)) || !(registers[2] & (1 << 28))) // OSXSAVE and AVX
+            return false;
+
+        if ((_xgetbv(0) & 6) != 6) // SSE and AVX states enabled by the OS
+            return false;
+
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0; // AVX2
+
+    #else
+
+        if (__get_cpuid_max(0, NULL) < 7)
+            return false;
+
+        unsigned int eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        if (!(ecx & (1 << 27)) || !(ecx & (1 << 28))) // OSXSAVE and AVX
+            return false;
+
+        unsigned int low, high;
+        __asm__ __volatile__ ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+        if ((low & 6) != 6) // SSE and AVX states enabled by the OS
+            return false;
+
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (ebx & (1 << 5)) != 0; // AVX2
+
+    #endif
+    }
+
+    // Detected once; until it is initialized (static initialization of other
+    // translation units) it is false and the other versions are used
+    const bool avx2Supported = isAvx2Supported();
+
+#else
+
+    const bool avx2Supported = false;
+
+#endif
+
+    // Are the AVX2 versions of the kernels used?
+    bool avx2Enabled = avx2Supported;
+
+    // Reference implementation of the alpha blending, which the vector versions reproduce exactly
+    inline void blendPixel(const sf::Uint8* src, sf::Uint8* dst)
+    {
+        sf::Uint8 alpha = src[3];
+        dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+        dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+        dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+        dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+    }
+
+#if defined(SFML_SIMD_SSE2)
+
+    // Divide 16-bit values up to 255 * 255 by 255, with the same result as an integer division
+    inline __m128i divide255(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_add_epi16(_mm_srli_epi16(x, 8), _mm_set1_epi16(1)));
+        return _mm_srli_epi16(x, 8);
+    }
+
+    // Blend 8 components widened to 16 bits
+    inline __m128i blend(__m128i src, __m128i dst, __m128i alpha)
+    {
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        return divide255(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse)));
+    }
+
+    // Reverse the order of the 4 pixels of a vector
+    inline __m128i reverse(__m128i pixels)
+    {
+        return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+
+    // Multiply 8 components widened to 16 bits, with the result rounded like (c * alpha + 127) / 255
+    inline __m128i multiply(__m128i components, __m128i alpha)
+    {
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(components, alpha), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    // Divide 16-bit values up to 255 * 255 by 255, with the same result as an integer division
+    inline uint8x8_t divide255(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vaddq_u16(vshrq_n_u16(x, 8), vdupq_n_u16(1)));
+        return vshrn_n_u16(x, 8);
+    }
+
+    // Blend 16 components of the same channel
+    inline uint8x16_t blend(uint8x16_t src, uint8x16_t dst, uint8x16_t alpha, uint8x16_t inverse)
+    {
+        uint16x8_t low  = vmlal_u8(vmull_u8(vget_low_u8(src),  vget_low_u8(alpha)),  vget_low_u8(dst),  vget_low_u8(inverse));
+        uint16x8_t high = vmlal_u8(vmull_u8(vget_high_u8(src), vget_high_u8(alpha)), vget_high_u8(dst), vget_high_u8(inverse));
+        return vcombine_u8(divide255(low), divide255(high));
+    }
+
+    // Reverse the order of the 4 pixels of a vector
+    inline uint8x16_t reverse(uint8x16_t pixels)
+    {
+        uint32x4_t swapped = vrev64q_u32(vreinterpretq_u32_u8(pixels));
+        return vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(swapped), vget_low_u32(swapped)));
+    }
+
+    // Multiply 8 components, with the result rounded like (c * alpha + 127) / 255
+    inline uint8x8_t multiply(uint8x8_t components, uint8x8_t alpha)
+    {
+        uint16x8_t x = vaddq_u16(vmull_u8(components, alpha), vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+    // Multiply 16 components of the same channel
+    inline uint8x16_t multiply(uint8x16_t components, uint8x16_t alpha)
+    {
+        return vcombine_u8(multiply(vget_low_u8(components),  vget_low_u8(alpha)),
+                           multiply(vget_high_u8(components), vget_high_u8(alpha)));
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count)
+{
+    std::size_t i = 0;
+
+    // Overlapping rows (when an image is copied onto itself) must be blended
+    // pixel by pixel, so that each pixel sees the previous ones already blended
+    bool overlap = (source < destination + count * 4) && (destination < source + count * 4);
+
+    if (!overlap)
+    {
+    #if defined(SFML_IMAGE_KERNELS_AVX2)
+
+        if (avx2Enabled)
+            i = blendPixelsAvx2(source, destination, count);
+
+    #endif
+
+    #if defined(SFML_SIMD_SSE2)
+
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i alphaBits = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+
+        // Process 4 pixels at once
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+            // Broadcast the alpha of each source pixel to its four components
+            __m128i alpha = _mm_srli_epi32(src, 24);
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+
+            // The alpha component is blended as if the source component was 255,
+            // which gives alpha + dst * (255 - alpha) / 255
+            src = _mm_or_si128(src, alphaBits);
+
+            __m128i low  = blend(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), _mm_unpacklo_epi8(alpha, zero));
+            __m128i high = blend(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), _mm_unpackhi_epi8(alpha, zero));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+        }
+
+    #elif defined(SFML_SIMD_NEON)
+
+        const uint8x16_t opaque = vdupq_n_u8(255);
+
+        // Process 16 pixels at once, with the channels deinterleaved
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t src = vld4q_u8(source + i * 4);
+            uint8x16x4_t dst = vld4q_u8(destination + i * 4);
+
+            uint8x16_t alpha   = src.val[3];
+            uint8x16_t inverse = vmvnq_u8(alpha);
+
+            // The alpha component is blended as if the source component was 255,
+            // which gives alpha + dst * (255 - alpha) / 255
+            dst.val[0] = blend(src.val[0], dst.val[0], alpha, inverse);
+            dst.val[1] = blend(src.val[1], dst.val[1], alpha, inverse);
+            dst.val[2] = blend(src.val[2], dst.val[2], alpha, inverse);
+            dst.val[3] = blend(opaque,     dst.val[3], alpha, inverse);
+
+            vst4q_u8(destination + i * 4, dst);
+        }
+
+    #endif
+    }
+
+    // Remaining pixels
+    for (; i < count; ++i)
+        blendPixel(source + i * 4, destination + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+
+    if (avx2Enabled)
+        i = maskPixelsAvx2(pixels, count, color, alpha);
+
+#endif
+
+#if defined(SFML_SIMD_SSE2)
+
+    // Compare whole pixels at once
+    Uint32 key;
+    std::memcpy(&key, color, 4);
+    const __m128i keys      = _mm_set1_epi32(static_cast<int>(key));
+    const __m128i alphaBits = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i alphas    = _mm_slli_epi32(_mm_set1_epi32(alpha), 24);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+
+        // Replace the alpha byte of the matching pixels
+        __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(pixel, keys), alphaBits);
+        pixel = _mm_or_si128(_mm_andnot_si128(selected, pixel), _mm_and_si128(selected, alphas));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), pixel);
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    const uint8x16_t red     = vdupq_n_u8(color[0]);
+    const uint8x16_t green   = vdupq_n_u8(color[1]);
+    const uint8x16_t blue    = vdupq_n_u8(color[2]);
+    const uint8x16_t opacity = vdupq_n_u8(color[3]);
+    const uint8x16_t alphas  = vdupq_n_u8(alpha);
+
+    // Process 16 pixels at once, with the channels deinterleaved
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t pixel = vld4q_u8(pixels + i * 4);
+
+        uint8x16_t matching = vandq_u8(vandq_u8(vceqq_u8(pixel.val[0], red),  vceqq_u8(pixel.val[1], green)),
+                                       vandq_u8(vceqq_u8(pixel.val[2], blue), vceqq_u8(pixel.val[3], opacity)));
+        pixel.val[3] = vbslq_u8(matching, alphas, pixel.val[3]);
+
+        vst4q_u8(pixels + i * 4, pixel);
+    }
+
+#endif
+
+    // Remaining pixels
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        if ((ptr[0] == color[0]) && (ptr[1] == color[1]) && (ptr[2] == color[2]) && (ptr[3] == color[3]))
+            ptr[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t reversed = 0;
+
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+
+    if (avx2Enabled)
+        reversed = reversePixelsAvx2(pixels, count);
+
+#endif
+
+    Uint8* left  = pixels + reversed * 4;
+    Uint8* right = pixels + (count - reversed) * 4;
+
+#if defined(SFML_SIMD_SSE2)
+
+    // Exchange blocks of 4 pixels from both ends, reversing them
+    while (right - left >= 32)
+    {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right - 16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left),       reverse(last));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right - 16), reverse(first));
+
+        left  += 16;
+        right -= 16;
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    // Exchange blocks of 4 pixels from both ends, reversing them
+    while (right - left >= 32)
+    {
+        uint8x16_t first = vld1q_u8(left);
+        uint8x16_t last  = vld1q_u8(right - 16);
+
+        vst1q_u8(left,       reverse(last));
+        vst1q_u8(right - 16, reverse(first));
+
+        left  += 16;
+        right -= 16;
+    }
+
+#endif
+
+    // Remaining pixels
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+
+    if (avx2Enabled)
+        i = swapBytesAvx2(first, second, size);
+
+#endif
+
+#if defined(SFML_SIMD_SSE2)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), a);
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t a = vld1q_u8(first + i);
+        uint8x16_t b = vld1q_u8(second + i);
+        vst1q_u8(first + i, b);
+        vst1q_u8(second + i, a);
+    }
+
+#endif
+
+    // Remaining bytes
+    std::swap_ranges(first + i, first + size, second + i);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_KERNELS_AVX2)
+
+    if (avx2Enabled)
+        i = premultiplyPixelsAvx2(pixels, count);
+
+#endif
+
+#if defined(SFML_SIMD_SSE2)
+
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i alphaBits = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+
+    // Process 4 pixels at once
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+
+        // Broadcast the alpha of each pixel to its color components,
+        // and multiply the alpha component by 255 to leave it unchanged
+        __m128i alpha = _mm_srli_epi32(pixel, 24);
+        alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+        alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        alpha = _mm_or_si128(alpha, alphaBits);
+
+        __m128i low  = multiply(_mm_unpacklo_epi8(pixel, zero), _mm_unpacklo_epi8(alpha, zero));
+        __m128i high = multiply(_mm_unpackhi_epi8(pixel, zero), _mm_unpackhi_epi8(alpha, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    // Process 16 pixels at once, with the channels deinterleaved
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t pixel = vld4q_u8(pixels + i * 4);
+
+        pixel.val[0] = multiply(pixel.val[0], pixel.val[3]);
+        pixel.val[1] = multiply(pixel.val[1], pixel.val[3]);
+        pixel.val[2] = multiply(pixel.val[2], pixel.val[3]);
+
+        vst4q_u8(pixels + i * 4, pixel);
+    }
+
+#endif
+
+    // Remaining pixels
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        ptr[0] = (ptr[0] * ptr[3] + 127) / 255;
+        ptr[1] = (ptr[1] * ptr[3] + 127) / 255;
+        ptr[2] = (ptr[2] * ptr[3] + 127) / 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    // Integer divisions don't vectorize; opaque pixels, the most
+    // common ones, are skipped as they are left unchanged anyway
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        unsigned int alpha = ptr[3];
+        if ((alpha > 0) && (alpha < 255))
+        {
+            ptr[0] = static_cast<Uint8>(std::min((ptr[0] * 255 + alpha / 2) / alpha, 255u));
+            ptr[1] = static_cast<Uint8>(std::min((ptr[1] * 255 + alpha / 2) / alpha, 255u));
+            ptr[2] = static_cast<Uint8>(std::min((ptr[2] * 255 + alpha / 2) / alpha, 255u));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void mapColorComponents(Uint8* pixels, std::size_t count, const Uint8* table)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        ptr[0] = table[ptr[0]];
+        ptr[1] = table[ptr[1]];
+        ptr[2] = table[ptr[2]];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool isAvx2Enabled()
+{
+    return avx2Enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void setAvx2Enabled(bool enabled)
+{
+    avx2Enabled = enabled && avx2Supported;
+}
+
+} // namespace priv
+
+} // namespace sf
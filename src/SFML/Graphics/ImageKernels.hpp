@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend a row of RGBA pixels over another one
+///
+/// Each destination component becomes
+/// (src * alpha + dst * (255 - alpha)) / 255, except the
+/// alpha component which becomes
+/// alpha + dst * (255 - alpha) / 255, where alpha is the
+/// alpha component of the source pixel.
+///
+/// \param source      Source pixels
+/// \param destination Destination pixels, blended in place
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Change the alpha of the pixels matching a color
+///
+/// \param pixels Pixels to modify, in place
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color to match
+/// \param alpha  Alpha given to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of a row of pixels
+///
+/// \param pixels Pixels to reverse, in place
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange the contents of two memory areas
+///
+/// \param first  First area
+/// \param second Second area, which must not overlap the first one
+/// \param size   Size of the areas, in bytes
+///
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the color components of pixels by their alpha
+///
+/// Each color component becomes round(c * alpha / 255).
+///
+/// \param pixels Pixels to modify, in place
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Divide the color components of pixels by their alpha
+///
+/// Each color component becomes min(255, round(c * 255 / alpha)),
+/// pixels with a zero alpha are left unchanged.
+///
+/// \param pixels Pixels to modify, in place
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the color components of pixels through a lookup table
+///
+/// \param pixels Pixels to modify, in place
+/// \param count  Number of pixels
+/// \param table  Table of 256 entries giving the new value of each component value
+///
+////////////////////////////////////////////////////////////
+void mapColorComponents(Uint8* pixels, std::size_t count, const Uint8* table);
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether the kernels use their AVX2 versions
+///
+/// The AVX2 versions are compiled on x86 targets whose compiler
+/// supports them, and used if the CPU and the operating system
+/// support AVX2.
+///
+/// \return True if the AVX2 versions are used
+///
+////////////////////////////////////////////////////////////
+bool isAvx2Enabled();
+
+////////////////////////////////////////////////////////////
+/// \brief Enable or disable the AVX2 versions of the kernels
+///
+/// This is meant for benchmarks and tests, which compare the
+/// code paths. Enabling them has no effect if they are not
+/// supported.
+///
+/// \param enabled True to use the AVX2 versions if supported
+///
+////////////////////////////////////////////////////////////
+void setAvx2Enabled(bool enabled);
+
+////////////////////////////////////////////////////////////
+// AVX2 versions of the kernels, defined in ImageKernelsAvx2.cpp.
+// They process the largest multiple of 8 pixels (32 bytes for
+// swapBytesAvx2, 8 pixels at each end for reversePixelsAvx2) and
+// return how many were processed, the caller handles the rest.
+// They must only be called when isAvx2Enabled() returns true.
+////////////////////////////////////////////////////////////
+std::size_t blendPixelsAvx2(const Uint8* source, Uint8* destination, std::size_t count);
+std::size_t maskPixelsAvx2(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+std::size_t reversePixelsAvx2(Uint8* pixels, std::size_t count);
+std::size_t swapBytesAvx2(Uint8* first, Uint8* second, std::size_t size);
+std::size_t premultiplyPixelsAvx2(Uint8* pixels, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
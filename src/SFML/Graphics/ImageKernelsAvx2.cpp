@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <immintrin.h>
+
+
+////////////////////////////////////////////////////////////
+// This file is compiled with AVX2 enabled, and its functions
+// are only called once the CPU has been checked to support it.
+// It must not use any inline function or template from other
+// headers (like the standard library): the compiler could emit
+// AVX2 instructions in them, and the linker could keep these
+// versions for the whole library.
+////////////////////////////////////////////////////////////
+namespace
+{
+    // Divide 16-bit values up to 255 * 255 by 255, with the same result as an integer division
+    inline __m256i divide255(__m256i x)
+    {
+        x = _mm256_add_epi16(x, _mm256_add_epi16(_mm256_srli_epi16(x, 8), _mm256_set1_epi16(1)));
+        return _mm256_srli_epi16(x, 8);
+    }
+
+    // Blend 16 components widened to 16 bits
+    inline __m256i blend(__m256i src, __m256i dst, __m256i alpha)
+    {
+        __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+        return divide255(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse)));
+    }
+
+    // Multiply 16 components widened to 16 bits, with the result rounded like (c * alpha + 127) / 255
+    inline __m256i multiply(__m256i components, __m256i alpha)
+    {
+        __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(components, alpha), _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    // Broadcast the alpha of each of the 8 pixels of a vector to its four components
+    inline __m256i broadcastAlpha(__m256i pixels)
+    {
+        __m256i alpha = _mm256_srli_epi32(pixels, 24);
+        alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 8));
+        return _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t blendPixelsAvx2(const Uint8* source, Uint8* destination, std::size_t count)
+{
+    const __m256i zero      = _mm256_setzero_si256();
+    const __m256i alphaBits = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+
+    // Process 8 pixels at once; unpacking and packing work on each
+    // 128-bit lane separately, which keeps the pixels in order
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+        __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * 4));
+
+        __m256i alpha = broadcastAlpha(src);
+
+        // The alpha component is blended as if the source component was 255,
+        // which gives alpha + dst * (255 - alpha) / 255
+        src = _mm256_or_si256(src, alphaBits);
+
+        __m256i low  = blend(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero), _mm256_unpacklo_epi8(alpha, zero));
+        __m256i high = blend(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero), _mm256_unpackhi_epi8(alpha, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(low, high));
+    }
+
+    return i;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t maskPixelsAvx2(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+    // Compare whole pixels at once
+    Uint32 key = color[0] | (color[1] << 8) | (color[2] << 16) | (static_cast<Uint32>(color[3]) << 24);
+    const __m256i keys      = _mm256_set1_epi32(static_cast<int>(key));
+    const __m256i alphaBits = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i alphas    = _mm256_slli_epi32(_mm256_set1_epi32(alpha), 24);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+
+        // Replace the alpha byte of the matching pixels
+        __m256i selected = _mm256_and_si256(_mm256_cmpeq_epi32(pixel, keys), alphaBits);
+        pixel = _mm256_or_si256(_mm256_andnot_si256(selected, pixel), _mm256_and_si256(selected, alphas));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), pixel);
+    }
+
+    return i;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t reversePixelsAvx2(Uint8* pixels, std::size_t count)
+{
+    const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+    // Exchange blocks of 8 pixels from both ends, reversing them
+    std::size_t i = 0;
+    for (; (i + 8) * 2 <= count; i += 8)
+    {
+        Uint8* left  = pixels + i * 4;
+        Uint8* right = pixels + (count - i - 8) * 4;
+
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+        __m256i last  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(left),  _mm256_permutevar8x32_epi32(last, reversed));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), _mm256_permutevar8x32_epi32(first, reversed));
+    }
+
+    return i;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t swapBytesAvx2(Uint8* first, Uint8* second, std::size_t size)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(first + i), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(second + i), a);
+    }
+
+    return i;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t premultiplyPixelsAvx2(Uint8* pixels, std::size_t count)
+{
+    const __m256i zero      = _mm256_setzero_si256();
+    const __m256i alphaBits = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+
+    // Process 8 pixels at once
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+
+        // Multiply the alpha component by 255 to leave it unchanged
+        __m256i alpha = _mm256_or_si256(broadcastAlpha(pixel), alphaBits);
+
+        __m256i low  = multiply(_mm256_unpacklo_epi8(pixel, zero), _mm256_unpacklo_epi8(alpha, zero));
+        __m256i high = multiply(_mm256_unpackhi_epi8(pixel, zero), _mm256_unpackhi_epi8(alpha, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), _mm256_packus_epi16(low, high));
+    }
+
+    return i;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -27,17 +27,163 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include <stb_image_write.h>
-extern "C"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    // State of the image decoded by a thread: the pixel array in which stb_image decodes
+    // it, and the reason of the last failure (stb_image stores it in a global variable)
+    struct DecodeState
+    {
+        unsigned char* buffer;        // Pixels of the image
+        std::size_t    size;          // Size of the pixels, in bytes
+        bool           used;          // Has the buffer been handed to stb_image?
+        const char*    failureReason; // Reason of the last failure
+    };
+
+    sf::ThreadLocalPtr<DecodeState> decodeState(NULL);
+    const char* sharedFailureReason = NULL;
+
+    // Protects the initialization of the state shared by the loading threads
+    sf::Mutex prepareMutex;
+
+    // stb_image allocation functions; the first allocation with the size of the decoded
+    // image gets the pixel array, so that the image is decoded directly into it (the JPEG
+    // decoder asks for one spare byte, which the pixel array always has in its capacity)
+    void* decodeMalloc(std::size_t size)
+    {
+        DecodeState* state = decodeState;
+        if (state && state->buffer && !state->used && ((size == state->size) || (size == state->size + 1)))
+        {
+            state->used = true;
+            return state->buffer;
+        }
+
+        return std::malloc(size);
+    }
+
+    void* decodeRealloc(void* pointer, std::size_t size)
+    {
+        DecodeState* state = decodeState;
+        if (state && state->used && (pointer == state->buffer))
+        {
+            // The pixel array can't grow: move its contents to a regular allocation
+            void* moved = std::malloc(size);
+            if (moved)
+            {
+                std::memcpy(moved, pointer, std::min(size, state->size));
+                state->used = false;
+            }
+
+            return moved;
+        }
+
+        return std::realloc(pointer, size);
+    }
+
+    void decodeFree(void* pointer)
+    {
+        DecodeState* state = decodeState;
+        if (state && state->used && (pointer == state->buffer))
+        {
+            // The pixel array is not ours to free, it can be handed out again
+            state->used = false;
+            return;
+        }
+
+        std::free(pointer);
+    }
+
+    // Largest decoded image: stb_image rejects allocations that don't fit in an int
+    // (stbi__mad3sizes_valid in its later versions)
+    const sf::Uint64 maxDecodedSize = INT_MAX;
+
+    // Largest ratio between the decoded and the encoded size of an image for which the
+    // pixel array is allocated from the header, before the image is decoded; this bounds
+    // what a corrupt header can make us allocate, while exceptionally well compressed
+    // images are only copied once after decoding
+    const sf::Uint64 maxExpansion = 1024;
+
+    // Check whether the size read in the header of an image can be trusted to pre-size the pixels
+    bool isPlausibleSize(int width, int height, sf::Uint64 encodedSize)
+    {
+        if ((width <= 0) || (height <= 0))
+            return false;
+
+        sf::Uint64 decodedSize = static_cast<sf::Uint64>(width) * static_cast<sf::Uint64>(height) * 4;
+
+        return (decodedSize <= maxDecodedSize) && (decodedSize / maxExpansion <= encodedSize);
+    }
+
+    // Give stb_image a decoding state of its own, for the lifetime of the scope,
+    // so that threads can decode images concurrently
+    class DecodeScope
+    {
+    public:
+
+        DecodeScope()
+        {
+            m_state.buffer        = NULL;
+            m_state.size          = 0;
+            m_state.used          = false;
+            m_state.failureReason = NULL;
+            decodeState = &m_state;
+        }
+
+        ~DecodeScope()
+        {
+            decodeState = NULL;
+        }
+
+        // Make stb_image decode the image into the pixel array, if the size read in
+        // its header is plausible; otherwise stb_image allocates the pixels itself,
+        // after checking the header, and they are copied to the pixel array
+        void decodeInto(std::vector<sf::Uint8>& pixels, int width, int height, sf::Uint64 encodedSize)
+        {
+            if (isPlausibleSize(width, height, encodedSize))
+            {
+                pixels.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+                pixels.reserve(pixels.size() + 1);
+            }
+
+            m_state.buffer = pixels.empty() ? NULL : &pixels[0];
+            m_state.size   = pixels.size();
+            m_state.used   = false;
+        }
+
+    private:
+
+        DecodeState m_state;
+    };
+}
+
+
+// Storage of the stb_image failure reason: the one of the decoding thread, if any
+static const char** stbiFailureReason()
 {
-    #include <jpeglib.h>
-    #include <jerror.h>
+    DecodeState* state = decodeState;
+    return state ? &state->failureReason : &sharedFailureReason;
 }
+
+
+#define stbi__g_failure_reason      *stbiFailureReason()
+#define STBI_MALLOC(size)           decodeMalloc(size)
+#define STBI_REALLOC(pointer, size) decodeRealloc(pointer, size)
+#define STBI_FREE(pointer)          decodeFree(pointer)
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <SFML/Graphics/ImageWriter.hpp>
+#include <SFML/System/OutputStream.hpp>
 #include <cctype>
+#include <cstdio>
 
 
 namespace
@@ -50,6 +196,66 @@ namespace
         return str;
     }
 
+    // Output stream writing to a file on disk
+    class FileWriter : public sf::OutputStream
+    {
+    public:
+
+        FileWriter(std::FILE* file) : m_file(file) {}
+
+        virtual sf::Int64 write(const void* data, sf::Int64 size)
+        {
+            return static_cast<sf::Int64>(std::fwrite(data, 1, static_cast<std::size_t>(size), m_file));
+        }
+
+    private:
+
+        std::FILE* m_file;
+    };
+
+    // Output stream appending to an array of bytes
+    class MemoryWriter : public sf::OutputStream
+    {
+    public:
+
+        MemoryWriter(std::vector<sf::Uint8>& output) : m_output(output) {}
+
+        virtual sf::Int64 write(const void* data, sf::Int64 size)
+        {
+            const sf::Uint8* bytes = static_cast<const sf::Uint8*>(data);
+            m_output.insert(m_output.end(), bytes, bytes + size);
+            return size;
+        }
+
+    private:
+
+        std::vector<sf::Uint8>& m_output;
+    };
+
+    // Tell whether a format, given by its extension in lower case, can be saved
+    bool isSaveFormat(const std::string& format)
+    {
+        return (format == "bmp") || (format == "tga") || (format == "png") || (format == "jpg") || (format == "jpeg");
+    }
+
+    // Write an image to a stream, in a given format (extension in lower case)
+    bool writeImage(sf::OutputStream& stream, const std::string& format, const std::vector<sf::Uint8>& pixels, const sf::Vector2u& size)
+    {
+        if (pixels.empty() || (size.x == 0) || (size.y == 0))
+            return false;
+
+        if (format == "bmp")
+            return sf::priv::writeBmp(stream, &pixels[0], size.x, size.y);
+        else if (format == "tga")
+            return sf::priv::writeTga(stream, &pixels[0], size.x, size.y);
+        else if (format == "png")
+            return sf::priv::writePng(stream, &pixels[0], size.x, size.y);
+        else if ((format == "jpg") || (format == "jpeg"))
+            return sf::priv::writeJpg(stream, &pixels[0], size.x, size.y);
+        else
+            return false;
+    }
+
     // stb_image callbacks that operate on a sf::InputStream
     int read(void* user, char* data, int size)
     {
@@ -66,6 +272,30 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Report a loading error to the caller, if it asked for it, or to the error output
+    void reportError(const std::string& message, std::string* error)
+    {
+        if (error)
+            *error = message;
+        else
+            sf::err() << message << std::endl;
+    }
+
+    // Store the pixels returned by stb_image, unless they were decoded in place
+    void adoptPixels(unsigned char* ptr, int width, int height, std::vector<sf::Uint8>& pixels)
+    {
+        if (!pixels.empty() && (ptr == &pixels[0]))
+            return;
+
+        // The size of the image was not known in advance: copy the loaded pixels to the pixel buffer
+        pixels.resize(static_cast<std::size_t>(width) * height * 4);
+        if (!pixels.empty())
+            std::memcpy(&pixels[0], ptr, pixels.size());
+
+        // Free the loaded pixels (they are now in our own pixel buffer)
+        stbi_image_free(ptr);
+    }
 }
 
 
@@ -82,6 +312,19 @@ ImageLoader& ImageLoader::getInstance()
 }
 
 
+////////////////////////////////////////////////////////////
+void ImageLoader::prepareThreads()
+{
+    Lock lock(prepareMutex);
+
+    getInstance();
+
+    // stb_image fills these tables on the first PNG decode, the same way
+    if (!stbi__zdefault_distance[31])
+        stbi__init_zdefaults();
+}
+
+
 ////////////////////////////////////////////////////////////
 ImageLoader::ImageLoader()
 {
@@ -97,16 +340,37 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
 {
-    // Clear the array (just in case)
+    // Clear the array (just in case), keeping its memory
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file)
+    {
+        reportError("Failed to load image \"" + filename + "\". Reason: Unable to open file", error);
+        return false;
+    }
+
+    // Read the size of the image first, so that it can be decoded directly into the pixel array
+    DecodeScope scope;
     int width = 0;
     int height = 0;
     int channels = 0;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    Uint64 fileSize = 0;
+    if (std::fseek(file, 0, SEEK_END) == 0)
+    {
+        long end = std::ftell(file);
+        fileSize = (end > 0) ? static_cast<Uint64>(end) : 0;
+        std::fseek(file, 0, SEEK_SET);
+    }
+    if (!stbi_info_from_file(file, &width, &height, &channels))
+        width = height = 0;
+
+    // Load the image and get a pointer to the pixels in memory
+    scope.decodeInto(pixels, width, height, fileSize);
+    unsigned char* ptr = stbi_load_from_file(file, &width, &height, &channels, STBI_rgb_alpha);
+    std::fclose(file);
 
     if (ptr)
     {
@@ -114,42 +378,41 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
         size.x = width;
         size.y = height;
 
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        adoptPixels(ptr, width, height, pixels);
 
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
+        reportError("Failed to load image \"" + filename + "\". Reason: " + stbi_failure_reason(), error);
 
+        pixels.clear();
         return false;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
+        // Clear the array (just in case), keeping its memory
         pixels.clear();
 
-        // Load the image and get a pointer to the pixels in memory
+        // Read the size of the image first, so that it can be decoded directly into the pixel array
+        DecodeScope scope;
         int width = 0;
         int height = 0;
         int channels = 0;
         const unsigned char* buffer = static_cast<const unsigned char*>(data);
+        if (!stbi_info_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels))
+            width = height = 0;
+
+        // Load the image and get a pointer to the pixels in memory
+        scope.decodeInto(pixels, width, height, dataSize);
         unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
 
         if (ptr)
@@ -158,38 +421,31 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
             size.x = width;
             size.y = height;
 
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+            adoptPixels(ptr, width, height, pixels);
 
             return true;
         }
         else
         {
             // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+            reportError(std::string("Failed to load image from memory. Reason: ") + stbi_failure_reason(), error);
 
+            pixels.clear();
             return false;
         }
     }
     else
     {
-        err() << "Failed to load image from memory, no data provided" << std::endl;
+        reportError("Failed to load image from memory, no data provided", error);
         return false;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
 {
-    // Clear the array (just in case)
+    // Clear the array (just in case), keeping its memory
     pixels.clear();
 
     // Make sure that the stream's reading position is at the beginning
@@ -201,10 +457,18 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     callbacks.skip = &skip;
     callbacks.eof  = &eof;
 
-    // Load the image and get a pointer to the pixels in memory
+    // Read the size of the image first, so that it can be decoded directly into the pixel array
+    DecodeScope scope;
     int width = 0;
     int height = 0;
     int channels = 0;
+    if (!stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &channels))
+        width = height = 0;
+
+    // Load the image and get a pointer to the pixels in memory
+    Int64 streamSize = stream.getSize();
+    stream.seek(0);
+    scope.decodeInto(pixels, width, height, (streamSize > 0) ? static_cast<Uint64>(streamSize) : 0);
     unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
 
     if (ptr)
@@ -213,23 +477,16 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
         size.x = width;
         size.y = height;
 
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        adoptPixels(ptr, width, height, pixels);
 
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        reportError(std::string("Failed to load image from stream. Reason: ") + stbi_failure_reason(), error);
 
+        pixels.clear();
         return false;
     }
 }
@@ -238,37 +495,19 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 ////////////////////////////////////////////////////////////
 bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
 {
-    // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
-    {
-        // Deduce the image type from its extension
+    // Deduce the image type from its extension
+    const std::size_t dot = filename.find_last_of('.');
+    const std::string extension = dot != std::string::npos ? toLower(filename.substr(dot + 1)) : "";
 
-        // Extract the extension
-        const std::size_t dot = filename.find_last_of('.');
-        const std::string extension = dot != std::string::npos ? toLower(filename.substr(dot + 1)) : "";
-
-        if (extension == "bmp")
-        {
-            // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                return true;
-        }
-        else if (extension == "tga")
-        {
-            // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                return true;
-        }
-        else if (extension == "png")
-        {
-            // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
-                return true;
-        }
-        else if (extension == "jpg" || extension == "jpeg")
+    // Make sure the image is not empty and the format is supported, before creating the file
+    if (!pixels.empty() && (size.x > 0) && (size.y > 0) && isSaveFormat(extension))
+    {
+        std::FILE* file = std::fopen(filename.c_str(), "wb");
+        if (file)
         {
-            // JPG format
-            if (writeJpg(filename, pixels, size.x, size.y))
+            FileWriter writer(file);
+            bool written = writeImage(writer, extension, pixels, size);
+            if ((std::fclose(file) == 0) && written)
                 return true;
         }
     }
@@ -279,56 +518,28 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+bool ImageLoader::saveImageToStream(OutputStream& stream, const std::string& format, const std::vector<Uint8>& pixels, const Vector2u& size)
 {
-    // Open the file to write in
-    FILE* file = fopen(filename.c_str(), "wb");
-    if (!file)
-        return false;
-
-    // Initialize the error handler
-    jpeg_compress_struct compressInfos;
-    jpeg_error_mgr errorManager;
-    compressInfos.err = jpeg_std_error(&errorManager);
-
-    // Initialize all the writing and compression infos
-    jpeg_create_compress(&compressInfos);
-    compressInfos.image_width      = width;
-    compressInfos.image_height     = height;
-    compressInfos.input_components = 3;
-    compressInfos.in_color_space   = JCS_RGB;
-    jpeg_stdio_dest(&compressInfos, file);
-    jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
-
-    // Get rid of the alpha channel
-    std::vector<Uint8> buffer(width * height * 3);
-    for (std::size_t i = 0; i < width * height; ++i)
-    {
-        buffer[i * 3 + 0] = pixels[i * 4 + 0];
-        buffer[i * 3 + 1] = pixels[i * 4 + 1];
-        buffer[i * 3 + 2] = pixels[i * 4 + 2];
-    }
-    Uint8* ptr = &buffer[0];
+    if (writeImage(stream, toLower(format), pixels, size))
+        return true;
 
-    // Start compression
-    jpeg_start_compress(&compressInfos, TRUE);
+    err() << "Failed to save image to stream (format \"" << format << "\")" << std::endl;
+    return false;
+}
 
-    // Write each row of the image
-    while (compressInfos.next_scanline < compressInfos.image_height)
-    {
-        JSAMPROW rawPointer = ptr + (compressInfos.next_scanline * width * 3);
-        jpeg_write_scanlines(&compressInfos, &rawPointer, 1);
-    }
 
-    // Finish compression
-    jpeg_finish_compress(&compressInfos);
-    jpeg_destroy_compress(&compressInfos);
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(std::vector<Uint8>& output, const std::string& format, const std::vector<Uint8>& pixels, const Vector2u& size)
+{
+    output.clear();
 
-    // Close the file
-    fclose(file);
+    MemoryWriter writer(output);
+    if (writeImage(writer, toLower(format), pixels, size))
+        return true;
 
-    return true;
+    err() << "Failed to save image to memory (format \"" << format << "\")" << std::endl;
+    output.clear();
+    return false;
 }
 
 } // namespace priv
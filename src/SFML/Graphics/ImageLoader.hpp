@@ -37,6 +37,7 @@
 namespace sf
 {
 class InputStream;
+class OutputStream;
 
 namespace priv
 {
@@ -56,17 +57,29 @@ public:
     ////////////////////////////////////////////////////////////
     static ImageLoader& getInstance();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the state shared by all the loading threads
+    ///
+    /// The instance and the default Huffman tables of the PNG
+    /// decoder are created on first use, which is not thread-safe.
+    /// This function must be called by the thread that starts
+    /// workers loading or saving images, before it starts them.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void prepareThreads();
+
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file on disk
     ///
     /// \param filename Path of image file to load
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param error    If not null, receives the error message instead of the error output
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = NULL);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
@@ -75,11 +88,12 @@ public:
     /// \param dataSize Size of the data to load, in bytes
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param error    If not null, receives the error message instead of the error output
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = NULL);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
@@ -87,11 +101,12 @@ public:
     /// \param stream Source stream to read from
     /// \param pixels Array of pixels to fill with loaded image
     /// \param size   Size of loaded image, in pixels
+    /// \param error  If not null, receives the error message instead of the error output
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = NULL);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -105,6 +120,32 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an image file, to a stream
+    ///
+    /// \param stream Destination stream
+    /// \param format Format of the file, given by its extension
+    /// \param pixels Array of pixels to save to image
+    /// \param size   Size of image to save, in pixels
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToStream(OutputStream& stream, const std::string& format, const std::vector<Uint8>& pixels, const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an image file, in memory
+    ///
+    /// \param output Array of bytes receiving the file
+    /// \param format Format of the file, given by its extension
+    /// \param pixels Array of pixels to save to image
+    /// \param size   Size of image to save, in pixels
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToMemory(std::vector<Uint8>& output, const std::string& format, const std::vector<Uint8>& pixels, const Vector2u& size);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -118,19 +159,6 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     ~ImageLoader();
-
-    ////////////////////////////////////////////////////////////
-    /// \brief Save an image file in JPEG format
-    ///
-    /// \param filename Path of image file to save
-    /// \param pixels   Array of pixels to save to image
-    /// \param width    Width of image to save, in pixels
-    /// \param height   Height of image to save, in pixels
-    ///
-    /// \return True if saving was successful
-    ///
-    ////////////////////////////////////////////////////////////
-    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
 };
 
 } // namespace priv
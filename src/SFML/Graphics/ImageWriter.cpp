@@ -0,0 +1,681 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageWriter.hpp>
+#include <SFML/System/OutputStream.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+extern "C"
+{
+    #include <jpeglib.h>
+    #include <jerror.h>
+}
+
+
+namespace
+{
+    // Number of rows converted and encoded at once, so that a strip takes about 256 KB
+    unsigned int getStripRows(std::size_t rowSize)
+    {
+        return static_cast<unsigned int>(std::max<std::size_t>(1, (256 * 1024) / rowSize));
+    }
+
+    // Write a whole buffer to a stream
+    bool writeData(sf::OutputStream& stream, const void* data, std::size_t size)
+    {
+        return (size == 0) || (stream.write(data, static_cast<sf::Int64>(size)) == static_cast<sf::Int64>(size));
+    }
+
+    // Append integers to a buffer, in little or big endian
+    void putLittle16(std::vector<sf::Uint8>& buffer, unsigned int value)
+    {
+        buffer.push_back(static_cast<sf::Uint8>(value));
+        buffer.push_back(static_cast<sf::Uint8>(value >> 8));
+    }
+
+    void putLittle32(std::vector<sf::Uint8>& buffer, sf::Uint32 value)
+    {
+        putLittle16(buffer, value & 0xFFFF);
+        putLittle16(buffer, value >> 16);
+    }
+
+    void putBig32(std::vector<sf::Uint8>& buffer, sf::Uint32 value)
+    {
+        buffer.push_back(static_cast<sf::Uint8>(value >> 24));
+        buffer.push_back(static_cast<sf::Uint8>(value >> 16));
+        buffer.push_back(static_cast<sf::Uint8>(value >> 8));
+        buffer.push_back(static_cast<sf::Uint8>(value));
+    }
+
+    // Write the rows of an image from bottom to top, each converted by a function
+    template <typename Converter>
+    bool writeRowsBottomUp(sf::OutputStream& stream, const sf::Uint8* pixels, unsigned int width, unsigned int height,
+                           std::size_t rowSize, Converter convert)
+    {
+        unsigned int stripRows = getStripRows(rowSize);
+        std::vector<sf::Uint8> strip(rowSize * std::min(stripRows, height));
+
+        unsigned int row = height;
+        while (row > 0)
+        {
+            unsigned int count = std::min(stripRows, row);
+            for (unsigned int i = 0; i < count; ++i)
+                convert(pixels + static_cast<std::size_t>(row - 1 - i) * width * 4, &strip[i * rowSize], width);
+
+            if (!writeData(stream, &strip[0], count * rowSize))
+                return false;
+
+            row -= count;
+        }
+
+        return true;
+    }
+
+    // Convert a row to 24-bit BMP pixels; transparent pixels are blended over magenta, as they always were
+    void convertBmpRow(const sf::Uint8* source, sf::Uint8* destination, unsigned int width)
+    {
+        static const int background[3] = {255, 0, 255};
+
+        for (unsigned int x = 0; x < width; ++x, source += 4, destination += 3)
+        {
+            for (int k = 0; k < 3; ++k)
+                destination[2 - k] = static_cast<sf::Uint8>(background[k] + ((source[k] - background[k]) * source[3]) / 255);
+        }
+    }
+
+    // Convert a row to 32-bit TGA pixels
+    void convertTgaRow(const sf::Uint8* source, sf::Uint8* destination, unsigned int width)
+    {
+        for (unsigned int x = 0; x < width; ++x, source += 4, destination += 4)
+        {
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+            destination[3] = source[3];
+        }
+    }
+
+    // Table-driven CRC-32, as used by PNG chunks
+    class Crc32
+    {
+    public:
+
+        Crc32()
+        {
+            for (sf::Uint32 i = 0; i < 256; ++i)
+            {
+                sf::Uint32 crc = i;
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+                m_table[i] = crc;
+            }
+        }
+
+        sf::Uint32 compute(const sf::Uint8* data, std::size_t size) const
+        {
+            sf::Uint32 crc = 0xFFFFFFFF;
+            for (std::size_t i = 0; i < size; ++i)
+                crc = (crc >> 8) ^ m_table[(data[i] ^ crc) & 0xFF];
+            return ~crc;
+        }
+
+    private:
+
+        sf::Uint32 m_table[256];
+    };
+
+    // Parameters of the compression
+    const std::size_t windowSize = 32768; // Largest distance of a match
+    const std::size_t hashSize   = 32768; // Number of hash chains
+    const std::size_t minMatch   = 3;     // Shortest match
+    const std::size_t maxMatch   = 258;   // Longest match
+    const int         maxChain   = 16;    // Number of positions tried for each match
+
+    // Streaming zlib compressor: LZ77 over a sliding window of 32 KB, with the fixed Huffman codes.
+    // Data is appended a strip at a time; only the last 32 KB of the previous strips are kept.
+    class Deflater
+    {
+    public:
+
+        Deflater() :
+        m_window  (),
+        m_base    (0),
+        m_position(0),
+        m_head    (hashSize, 0),
+        m_previous(windowSize, 0),
+        m_output  (),
+        m_bits    (0),
+        m_bitCount(0),
+        m_adlerA  (1),
+        m_adlerB  (0)
+        {
+            // Reversed fixed Huffman codes of the literal/length symbols
+            for (int symbol = 0; symbol < 288; ++symbol)
+            {
+                int code, length;
+                if (symbol < 144)      {code = 0x30 + symbol;          length = 8;}
+                else if (symbol < 256) {code = 0x190 + symbol - 144;   length = 9;}
+                else if (symbol < 280) {code = symbol - 256;           length = 7;}
+                else                   {code = 0xC0 + symbol - 280;    length = 8;}
+
+                m_codes[symbol]   = reverse(code, length);
+                m_lengths[symbol] = length;
+            }
+
+            // zlib header, then a single final block using the fixed Huffman codes
+            m_output.push_back(0x78);
+            m_output.push_back(0x5E);
+            writeBits(1, 1);
+            writeBits(1, 2);
+        }
+
+        // Compress data following the previous one; the end of it is kept until more data comes
+        void compress(const sf::Uint8* data, std::size_t size)
+        {
+            updateAdler(data, size);
+            m_window.insert(m_window.end(), data, data + size);
+            process(false);
+        }
+
+        // Compress the remaining data and terminate the stream
+        void finish()
+        {
+            process(true);
+
+            writeSymbol(256);
+            if (m_bitCount > 0)
+                writeBits(0, 8 - m_bitCount);
+
+            sf::Uint32 adler = (m_adlerB << 16) | m_adlerA;
+            putBig32(m_output, adler);
+        }
+
+        // Compressed data produced so far, to be consumed by the caller
+        std::vector<sf::Uint8>& getOutput()
+        {
+            return m_output;
+        }
+
+    private:
+
+        static int reverse(int code, int length)
+        {
+            int result = 0;
+            for (int i = 0; i < length; ++i)
+                result = (result << 1) | ((code >> i) & 1);
+            return result;
+        }
+
+        void writeBits(sf::Uint32 value, int count)
+        {
+            m_bits |= value << m_bitCount;
+            m_bitCount += count;
+            while (m_bitCount >= 8)
+            {
+                m_output.push_back(static_cast<sf::Uint8>(m_bits));
+                m_bits >>= 8;
+                m_bitCount -= 8;
+            }
+        }
+
+        void writeSymbol(int symbol)
+        {
+            writeBits(m_codes[symbol], m_lengths[symbol]);
+        }
+
+        void writeMatch(std::size_t length, std::size_t distance)
+        {
+            static const unsigned short lengthBase[]  = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static const unsigned char  lengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+            static const unsigned short distBase[]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+            static const unsigned char  distExtra[]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+            int i = 28;
+            while (lengthBase[i] > length)
+                --i;
+            writeSymbol(257 + i);
+            writeBits(static_cast<sf::Uint32>(length - lengthBase[i]), lengthExtra[i]);
+
+            int j = 29;
+            while (distBase[j] > distance)
+                --j;
+            writeBits(reverse(j, 5), 5);
+            writeBits(static_cast<sf::Uint32>(distance - distBase[j]), distExtra[j]);
+        }
+
+        void updateAdler(const sf::Uint8* data, std::size_t size)
+        {
+            while (size > 0)
+            {
+                // 5552 is the largest count for which the sums can't overflow before the modulo
+                std::size_t count = std::min<std::size_t>(size, 5552);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_adlerA += data[i];
+                    m_adlerB += m_adlerA;
+                }
+                m_adlerA %= 65521;
+                m_adlerB %= 65521;
+                data += count;
+                size -= count;
+            }
+        }
+
+        const sf::Uint8* at(std::size_t position) const
+        {
+            return &m_window[position - m_base];
+        }
+
+        std::size_t hash(std::size_t position) const
+        {
+            const sf::Uint8* data = at(position);
+            return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & (hashSize - 1);
+        }
+
+        // Register a position in the hash chains (positions are stored plus one, 0 ends a chain)
+        void insert(std::size_t position, std::size_t end)
+        {
+            if (position + minMatch > end)
+                return;
+
+            std::size_t h = hash(position);
+            m_previous[position & (windowSize - 1)] = m_head[h];
+            m_head[h] = position + 1;
+        }
+
+        // Find the longest match of the data at a position in the window
+        std::size_t findMatch(std::size_t position, std::size_t end, std::size_t& distance) const
+        {
+            if (position + minMatch > end)
+                return 0;
+
+            const sf::Uint8* current = at(position);
+            std::size_t limit = std::min(maxMatch, end - position);
+            std::size_t best = 0;
+            std::size_t match = m_head[hash(position)];
+            for (int chain = 0; (match > 0) && (chain < maxChain); ++chain)
+            {
+                std::size_t candidate = match - 1;
+                if ((candidate >= position) || (position - candidate > windowSize))
+                    break;
+
+                const sf::Uint8* data = at(candidate);
+                std::size_t length = 0;
+                while ((length < limit) && (data[length] == current[length]))
+                    ++length;
+
+                if (length > best)
+                {
+                    best = length;
+                    distance = position - candidate;
+                    if (length == limit)
+                        break;
+                }
+
+                std::size_t next = m_previous[candidate & (windowSize - 1)];
+                if (next >= match)
+                    break;
+                match = next;
+            }
+
+            return best;
+        }
+
+        void process(bool final)
+        {
+            std::size_t end = m_base + m_window.size();
+
+            // Keep enough data ahead for the longest match, unless there's no more data to come
+            std::size_t limit = final ? end : (end > maxMatch ? end - maxMatch : 0);
+            while (m_position < limit)
+            {
+                std::size_t distance = 0;
+                std::size_t length = findMatch(m_position, end, distance);
+                insert(m_position, end);
+
+                // Lazy matching: prefer a literal if the next position has a longer match
+                if ((length >= minMatch) && (length < maxMatch))
+                {
+                    std::size_t nextDistance = 0;
+                    if (findMatch(m_position + 1, end, nextDistance) > length)
+                        length = 0;
+                }
+
+                if (length >= minMatch)
+                {
+                    writeMatch(length, distance);
+                    for (std::size_t i = 1; i < length; ++i)
+                        insert(m_position + i, end);
+                    m_position += length;
+                }
+                else
+                {
+                    writeSymbol(*at(m_position));
+                    m_position++;
+                }
+            }
+
+            // Drop the data that can no longer be referenced
+            if (m_position > m_base + windowSize)
+            {
+                std::size_t drop = m_position - windowSize - m_base;
+                m_window.erase(m_window.begin(), m_window.begin() + drop);
+                m_base += drop;
+            }
+        }
+
+        std::vector<sf::Uint8>   m_window;        // Data to compress, preceded by the last 32 KB already compressed
+        std::size_t              m_base;          // Position of the first byte of the window in the whole data
+        std::size_t              m_position;      // Position of the next byte to compress
+        std::vector<std::size_t> m_head;          // Last position of each hash
+        std::vector<std::size_t> m_previous;      // Previous position with the same hash, for each position of the window
+        std::vector<sf::Uint8>   m_output;        // Compressed data not consumed yet
+        sf::Uint32               m_bits;          // Bits not written yet
+        int                      m_bitCount;      // Number of bits not written yet
+        int                      m_codes[288];    // Reversed Huffman codes of the literal/length symbols
+        int                      m_lengths[288];  // Lengths of the Huffman codes
+        sf::Uint32               m_adlerA;        // Adler-32 checksum of the data, first sum
+        sf::Uint32               m_adlerB;        // Adler-32 checksum of the data, second sum
+    };
+
+    // Write a PNG chunk
+    bool writeChunk(sf::OutputStream& stream, const Crc32& crc, const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        std::vector<sf::Uint8> chunk;
+        chunk.reserve(size + 12);
+        putBig32(chunk, static_cast<sf::Uint32>(size));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data, data + size);
+        putBig32(chunk, crc.compute(&chunk[4], size + 4));
+
+        return writeData(stream, &chunk[0], chunk.size());
+    }
+
+    // Apply a PNG filter to a row; prior is the unfiltered previous row (zeros for the first one)
+    void filterRow(int type, const sf::Uint8* row, const sf::Uint8* prior, sf::Uint8* filtered, std::size_t size)
+    {
+        const std::size_t bpp = 4;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            int left      = (i >= bpp) ? row[i - bpp] : 0;
+            int up        = prior[i];
+            int upperLeft = (i >= bpp) ? prior[i - bpp] : 0;
+            int predictor = 0;
+            switch (type)
+            {
+                case 1: predictor = left; break;
+                case 2: predictor = up; break;
+                case 3: predictor = (left + up) / 2; break;
+                case 4:
+                {
+                    int p = left + up - upperLeft;
+                    int pa = std::abs(p - left), pb = std::abs(p - up), pc = std::abs(p - upperLeft);
+                    predictor = ((pa <= pb) && (pa <= pc)) ? left : (pb <= pc) ? up : upperLeft;
+                    break;
+                }
+                default: break;
+            }
+            filtered[i] = static_cast<sf::Uint8>(row[i] - predictor);
+        }
+    }
+
+    // Destination of libjpeg that writes to a sf::OutputStream
+    struct JpegDestination
+    {
+        jpeg_destination_mgr manager;
+        sf::OutputStream*    stream;
+        JOCTET               buffer[4096];
+        bool                 failed;
+    };
+
+    void initDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        destination->manager.next_output_byte = destination->buffer;
+        destination->manager.free_in_buffer   = sizeof(destination->buffer);
+    }
+
+    boolean emptyOutputBuffer(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        if (!writeData(*destination->stream, destination->buffer, sizeof(destination->buffer)))
+            destination->failed = true;
+
+        initDestination(compressInfos);
+        return TRUE;
+    }
+
+    void termDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        std::size_t size = sizeof(destination->buffer) - destination->manager.free_in_buffer;
+        if (!writeData(*destination->stream, destination->buffer, size))
+            destination->failed = true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool writeBmp(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height)
+{
+    std::size_t rowSize = (static_cast<std::size_t>(width) * 3 + 3) & ~static_cast<std::size_t>(3);
+
+    // File header, then bitmap header
+    std::vector<Uint8> header;
+    header.push_back('B');
+    header.push_back('M');
+    putLittle32(header, static_cast<Uint32>(14 + 40 + rowSize * height));
+    putLittle32(header, 0);
+    putLittle32(header, 14 + 40);
+    putLittle32(header, 40);
+    putLittle32(header, width);
+    putLittle32(header, height);
+    putLittle16(header, 1);
+    putLittle16(header, 24);
+    for (int i = 0; i < 6; ++i)
+        putLittle32(header, 0);
+
+    return writeData(stream, &header[0], header.size()) &&
+           writeRowsBottomUp(stream, pixels, width, height, rowSize, convertBmpRow);
+}
+
+
+////////////////////////////////////////////////////////////
+bool writeTga(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height)
+{
+    // Uncompressed true-color image, with 8 bits of alpha, stored from bottom to top
+    std::vector<Uint8> header;
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(2);
+    putLittle16(header, 0);
+    putLittle16(header, 0);
+    header.push_back(0);
+    putLittle16(header, 0);
+    putLittle16(header, 0);
+    putLittle16(header, width);
+    putLittle16(header, height);
+    header.push_back(32);
+    header.push_back(8);
+
+    return writeData(stream, &header[0], header.size()) &&
+           writeRowsBottomUp(stream, pixels, width, height, static_cast<std::size_t>(width) * 4, convertTgaRow);
+}
+
+
+////////////////////////////////////////////////////////////
+bool writePng(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height)
+{
+    static const Uint8 signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+    if (!writeData(stream, signature, sizeof(signature)))
+        return false;
+
+    // Header: 8 bits per component, RGBA, no interlacing
+    Crc32 crc;
+    std::vector<Uint8> header;
+    putBig32(header, width);
+    putBig32(header, height);
+    header.push_back(8);
+    header.push_back(6);
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+    if (!writeChunk(stream, crc, "IHDR", &header[0], header.size()))
+        return false;
+
+    // Filter the rows, with the filter that gives the smallest values, and compress them a strip at a time
+    std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+    unsigned int stripRows = getStripRows(rowSize + 1);
+    std::vector<Uint8> candidates(rowSize * 5);
+    std::vector<Uint8> zeros(rowSize, 0);
+    std::vector<Uint8> strip;
+    strip.reserve((rowSize + 1) * std::min(stripRows, height));
+    unsigned int rowsInStrip = 0;
+    Deflater deflater;
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const Uint8* row   = pixels + y * rowSize;
+        const Uint8* prior = (y > 0) ? row - rowSize : &zeros[0];
+
+        int bestType = 0;
+        unsigned long bestSum = 0;
+        for (int type = 0; type < 5; ++type)
+        {
+            Uint8* filtered = &candidates[type * rowSize];
+            filterRow(type, row, prior, filtered, rowSize);
+
+            unsigned long sum = 0;
+            for (std::size_t i = 0; i < rowSize; ++i)
+                sum += std::abs(static_cast<int>(static_cast<signed char>(filtered[i])));
+
+            if ((type == 0) || (sum < bestSum))
+            {
+                bestType = type;
+                bestSum = sum;
+            }
+        }
+
+        strip.push_back(static_cast<Uint8>(bestType));
+        strip.insert(strip.end(), candidates.begin() + bestType * rowSize, candidates.begin() + (bestType + 1) * rowSize);
+
+        if ((++rowsInStrip == stripRows) || (y + 1 == height))
+        {
+            deflater.compress(&strip[0], strip.size());
+            strip.clear();
+            rowsInStrip = 0;
+
+            // Write the compressed data in chunks of reasonable size
+            std::vector<Uint8>& output = deflater.getOutput();
+            if (output.size() >= 64 * 1024)
+            {
+                if (!writeChunk(stream, crc, "IDAT", &output[0], output.size()))
+                    return false;
+                output.clear();
+            }
+        }
+    }
+
+    deflater.finish();
+    std::vector<Uint8>& output = deflater.getOutput();
+
+    return writeChunk(stream, crc, "IDAT", &output[0], output.size()) &&
+           writeChunk(stream, crc, "IEND", NULL, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool writeJpg(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height)
+{
+    // Initialize the error handler
+    jpeg_compress_struct compressInfos;
+    jpeg_error_mgr errorManager;
+    compressInfos.err = jpeg_std_error(&errorManager);
+
+    // Initialize the destination, which writes to the stream
+    JpegDestination destination;
+    destination.manager.init_destination    = &initDestination;
+    destination.manager.empty_output_buffer = &emptyOutputBuffer;
+    destination.manager.term_destination    = &termDestination;
+    destination.stream                      = &stream;
+    destination.failed                      = false;
+
+    // Initialize all the writing and compression infos
+    jpeg_create_compress(&compressInfos);
+    compressInfos.image_width      = width;
+    compressInfos.image_height     = height;
+    compressInfos.input_components = 3;
+    compressInfos.in_color_space   = JCS_RGB;
+    compressInfos.dest             = &destination.manager;
+    jpeg_set_defaults(&compressInfos);
+    jpeg_set_quality(&compressInfos, 90, TRUE);
+
+    // Start compression
+    jpeg_start_compress(&compressInfos, TRUE);
+
+    // Write the rows a strip at a time, getting rid of the alpha channel
+    std::size_t rowSize = static_cast<std::size_t>(width) * 3;
+    unsigned int stripRows = std::min(getStripRows(rowSize), height);
+    std::vector<Uint8> strip(rowSize * stripRows);
+    std::vector<JSAMPROW> rows(stripRows);
+    for (unsigned int i = 0; i < stripRows; ++i)
+        rows[i] = &strip[i * rowSize];
+
+    while (compressInfos.next_scanline < compressInfos.image_height)
+    {
+        unsigned int first = compressInfos.next_scanline;
+        unsigned int count = std::min(stripRows, height - first);
+        const Uint8* source = pixels + static_cast<std::size_t>(first) * width * 4;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(count) * width; ++i)
+        {
+            strip[i * 3 + 0] = source[i * 4 + 0];
+            strip[i * 3 + 1] = source[i * 4 + 1];
+            strip[i * 3 + 2] = source[i * 4 + 2];
+        }
+
+        // libjpeg may not consume all the rows at once
+        unsigned int written = 0;
+        while (written < count)
+            written += jpeg_write_scanlines(&compressInfos, &rows[written], count - written);
+    }
+
+    // Finish compression
+    jpeg_finish_compress(&compressInfos);
+    jpeg_destroy_compress(&compressInfos);
+
+    return !destination.failed;
+}
+
+} // namespace priv
+
+} // namespace sf
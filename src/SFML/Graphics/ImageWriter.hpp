@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEWRITER_HPP
+#define SFML_IMAGEWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+class OutputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Write RGBA pixels to a stream as a BMP file
+///
+/// The file has 24 bits per pixel: transparent pixels are
+/// blended over magenta.
+///
+/// \param stream Destination stream
+/// \param pixels RGBA pixels of the image
+/// \param width  Width of the image
+/// \param height Height of the image
+///
+/// \return True if the file was written
+///
+////////////////////////////////////////////////////////////
+bool writeBmp(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height);
+
+////////////////////////////////////////////////////////////
+/// \brief Write RGBA pixels to a stream as an uncompressed TGA file
+///
+/// \param stream Destination stream
+/// \param pixels RGBA pixels of the image
+/// \param width  Width of the image
+/// \param height Height of the image
+///
+/// \return True if the file was written
+///
+////////////////////////////////////////////////////////////
+bool writeTga(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height);
+
+////////////////////////////////////////////////////////////
+/// \brief Write RGBA pixels to a stream as a PNG file
+///
+/// The rows are filtered and compressed a strip at a time,
+/// and each strip is written as soon as it is compressed:
+/// the memory used doesn't depend on the height of the image.
+///
+/// \param stream Destination stream
+/// \param pixels RGBA pixels of the image
+/// \param width  Width of the image
+/// \param height Height of the image
+///
+/// \return True if the file was written
+///
+////////////////////////////////////////////////////////////
+bool writePng(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height);
+
+////////////////////////////////////////////////////////////
+/// \brief Write RGBA pixels to a stream as a JPEG file
+///
+/// The alpha channel is dropped, a strip of rows at a time.
+///
+/// \param stream Destination stream
+/// \param pixels RGBA pixels of the image
+/// \param width  Width of the image
+/// \param height Height of the image
+///
+/// \return True if the file was written
+///
+////////////////////////////////////////////////////////////
+bool writeJpg(OutputStream& stream, const Uint8* pixels, unsigned int width, unsigned int height);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEWRITER_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ReadbackTicket.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ReadbackTicket::ReadbackTicket() :
+m_first(0),
+m_count(0)
+{
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        m_slots[i].buffer  = 0;
+        m_slots[i].size    = 0;
+        m_slots[i].fence   = NULL;
+        m_slots[i].pixels  = Vector2u(0, 0);
+        m_slots[i].pitch   = 0;
+        m_slots[i].flipped = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ReadbackTicket::~ReadbackTicket()
+{
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        if (m_slots[i].fence)
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_slots[i].fence)));
+
+        if (m_slots[i].buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_slots[i].buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ReadbackTicket::getPendingCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackTicket::isReady() const
+{
+    if (m_count == 0)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    const Slot& slot = m_slots[m_first];
+    if (slot.fence)
+    {
+        TransientContextLock lock;
+
+        // Don't wait, only check the state of the fence; the pending commands
+        // are submitted if needed, otherwise the fence may never be reached
+        GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+        glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(slot.fence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+
+        return status != GLEXT_GL_TIMEOUT_EXPIRED;
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackTicket::retrieve(Image& image)
+{
+    if (m_count == 0)
+        return false;
+
+    Slot& slot = m_slots[m_first];
+    m_first = (m_first + 1) % 2;
+    m_count--;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // The fence is not needed to wait: mapping the buffer waits for the transfer
+    if (slot.fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(slot.fence)));
+        slot.fence = NULL;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+
+    const void* mapping = NULL;
+    glCheck(mapping = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+    if (!mapping)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+        err() << "Failed to retrieve the pixels of a readback, the buffer couldn't be mapped" << std::endl;
+        return false;
+    }
+
+    // Write the rows directly to the storage of the image, keeping its memory if possible
+    unsigned int rowSize = slot.pixels.x * 4;
+    image.m_size = slot.pixels;
+    image.m_pixels.resize(rowSize * slot.pixels.y);
+
+    if (!image.m_pixels.empty())
+    {
+        const Uint8* src = static_cast<const Uint8*>(mapping);
+        Uint8* dst = &image.m_pixels[0];
+        int srcPitch = static_cast<int>(slot.pitch);
+
+        // Handle the case where source pixels are flipped vertically
+        if (slot.flipped)
+        {
+            src += srcPitch * (slot.pixels.y - 1);
+            srcPitch = -srcPitch;
+        }
+
+        for (unsigned int i = 0; i < slot.pixels.y; ++i)
+        {
+            std::memcpy(dst, src, rowSize);
+            src += srcPitch;
+            dst += rowSize;
+        }
+    }
+
+    glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackTicket::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object && GLEXT_sync;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadbackTicket::beginRead(std::size_t size)
+{
+    if (m_count == 2)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    Slot& slot = m_slots[(m_first + m_count) % 2];
+
+    if (!slot.buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        slot.buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!slot.buffer)
+    {
+        err() << "Failed to request a readback, the pixel buffer couldn't be created" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+
+    // Only reallocate the storage when it's too small, so that recording frames doesn't allocate
+    if (slot.size < size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptrARB>(size), NULL, GLEXT_GL_STREAM_READ));
+        slot.size = size;
+    }
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadbackTicket::endRead(const Vector2u& pixels, unsigned int pitch, bool flipped)
+{
+#ifndef SFML_OPENGL_ES
+
+    Slot& slot = m_slots[(m_first + m_count) % 2];
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+    glCheck(slot.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    slot.pixels  = pixels;
+    slot.pitch   = pitch;
+    slot.flipped = flipped;
+
+    m_count++;
+
+#endif
+}
+
+} // namespace sf
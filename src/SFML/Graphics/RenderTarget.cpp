@@ -27,16 +27,29 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/CoreRenderer.hpp>
+#include <SFML/Graphics/StreamBuffer.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 namespace
 {
+    // Render targets which have batching enabled, so that they can be
+    // flushed before an internal texture that they may use is modified
+    sf::Mutex batchingTargetsMutex;
+    std::vector<sf::RenderTarget*> batchingTargets;
+
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
     sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
     {
@@ -74,6 +87,19 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // Get the primitive type that a batch must use to hold primitives of the given type
+    sf::PrimitiveType getBatchPrimitiveType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::Points:        return sf::Points;
+            case sf::Lines:
+            case sf::LineStrip:     return sf::Lines;
+            default:                return sf::Triangles;
+        }
+    }
 }
 
 
@@ -81,25 +107,51 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      ()
+m_defaultView  (),
+m_view         (),
+m_cache        (),
+m_batch        (),
+m_statistics   (),
+m_queue        (NULL),
+m_coreRenderer (NULL),
+m_streamBuffer (NULL)
 {
     m_cache.glStatesSet = false;
+    m_cache.vertexCache.resize(StatesCache::DefaultVertexCacheSize);
+    m_batch.enabled = false;
+    m_batch.type = Triangles;
+    m_batch.texture = NULL;
+    m_batch.textureId = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    if (m_batch.enabled)
+    {
+        Lock lock(batchingTargetsMutex);
+        batchingTargets.erase(std::remove(batchingTargets.begin(), batchingTargets.end(), this), batchingTargets.end());
+    }
+
+    delete m_coreRenderer;
+    delete m_streamBuffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Render the pending primitives before they get erased
+    flush();
+
     if (setActive(true))
     {
+        // First set the persistent OpenGL states if it's the very first call,
+        // this also selects the rendering backend that applyTexture relies on
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
@@ -112,6 +164,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending primitives must be rendered with the view they were drawn with
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -204,6 +259,16 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Record the primitives if this target feeds a draw queue
+    if (m_queue)
+    {
+        m_queue->record(vertices, vertexCount, type, states);
+        return;
+    }
+
+    // Update the statistics
+    m_statistics.drawsSubmitted++;
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -214,96 +279,279 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         #define GL_QUADS 0
     #endif
 
+    // Merge the primitives into the current batch if possible
+    if (m_batch.enabled && !states.shader)
+    {
+        appendToBatch(vertices, vertexCount, type, states);
+        return;
+    }
+
+    // The pending batch must be rendered first to preserve the drawing order
+    flush();
+
     if (setActive(true))
     {
-        // First set the persistent OpenGL states if it's the very first call
+        // First set the persistent OpenGL states if it's the very first call,
+        // this also selects the rendering backend
         if (!m_cache.glStatesSet)
             resetGLStates();
 
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        // Check if the vertex count is low enough so that we can pre-transform them;
+        // the core profile backend transforms vertices on the GPU
+        bool useVertexCache = !m_coreRenderer && (vertexCount <= m_cache.vertexCache.size());
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
-
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
-        }
-        else
-        {
-            applyTransform(states.transform);
+            std::copy(vertices, vertices + vertexCount, m_cache.vertexCache.begin());
+            states.transform.transformPoints(&vertices[0].position, sizeof(Vertex),
+                                             &m_cache.vertexCache[0].position, sizeof(Vertex), vertexCount);
         }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
-
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
-
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
-
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+        setupDraw(useVertexCache, states);
 
         // If we pre-transform the vertices, we must use our internal vertex cache
         if (useVertexCache)
         {
             // ... and if we already used it previously, we don't need to set the pointers again
             if (!m_cache.useVertexCache)
-                vertices = m_cache.vertexCache;
+                vertices = &m_cache.vertexCache[0];
             else
                 vertices = NULL;
         }
 
-        // Setup the pointers to the vertices' components
+        // Setup the pointers to the vertices' components; the few vertices
+        // of the cache stay in client memory, the others are streamed
         if (vertices)
+            setupVertices(vertices, vertexCount, !useVertexCache);
+
+        drawPrimitives(type, 0, vertexCount);
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = useVertexCache;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // Record the primitives if this target feeds a draw queue
+    if (m_queue)
+    {
+        m_queue->record(vertexBuffer, firstVertex, vertexCount, states);
+        return;
+    }
+
+    // Update the statistics
+    m_statistics.drawsSubmitted++;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
         }
+    #endif
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
+    // The pending batch must be rendered first to preserve the drawing order
+    flush();
 
-        // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
+    if (setActive(true))
+    {
+        // Vertices are stored in graphics memory, they are always transformed by the graphics card
+        setupDraw(false, states);
 
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
+        if (m_coreRenderer)
+        {
+            m_coreRenderer->setVertexBuffer(vertexBuffer.getNativeHandle());
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+        }
+        else
+        {
+            // Bind the vertex buffer and setup the offsets of the vertices' components inside it
+            VertexBuffer::bind(&vertexBuffer);
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
 
-        // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-        // This prevents a bug where some drivers do not clear RenderTextures properly.
-        if (states.texture && states.texture->m_fboAttachment)
-            applyTexture(NULL);
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
 
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
+            // Unbind the vertex buffer, client-side vertex arrays must not be sourced from it
+            VertexBuffer::bind(NULL);
+        }
+
+        cleanupDraw(states);
+
+        // The vertex pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 std::size_t instanceCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || (instanceCount == 0))
+        return;
+
+    // Update the statistics
+    m_statistics.drawsSubmitted++;
+
+    // The pending batch must be rendered first to preserve the drawing order
+    flush();
+
+    if (setActive(true))
+    {
+        // Instances are transformed by the shader, so the vertex cache is never used
+        setupDraw(false, states);
+
+        // Setup the pointers to the vertices' components
+        setupVertices(vertices, vertexCount, true);
+
+        drawPrimitives(type, 0, vertexCount, instanceCount);
+        cleanupDraw(states);
+
+        // The vertex pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setVertexCacheSize(std::size_t size)
+{
+    // The cache must hold at least one vertex, so that it can always be addressed
+    m_cache.vertexCache.resize(std::max<std::size_t>(size, 1));
+
+    // The vertex pointers may no longer refer to the vertex cache
+    m_cache.useVertexCache = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::getVertexCacheSize() const
+{
+    return m_cache.vertexCache.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (enabled == m_batch.enabled)
+        return;
+
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+
+    Lock lock(batchingTargetsMutex);
+    if (enabled)
+        batchingTargets.push_back(this);
+    else
+        batchingTargets.erase(std::remove(batchingTargets.begin(), batchingTargets.end(), this), batchingTargets.end());
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    // Nothing to render?
+    if (m_batch.vertices.empty())
+        return;
+
+    if (setActive(true))
+    {
+        // Batched vertices are already transformed
+        RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, NULL);
+        setupDraw(false, states);
+
+        // Setup the pointers to the vertices' components
+        setupVertices(&m_batch.vertices[0], m_batch.vertices.size(), true);
+
+        drawPrimitives(m_batch.type, 0, m_batch.vertices.size());
+        cleanupDraw(states);
+
+        // The vertex pointers no longer refer to the vertex cache
+        m_cache.useVertexCache = false;
     }
+
+    // Keep the allocated memory for the next batch
+    m_batch.vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flushBatches(const Texture& texture)
+{
+    Lock lock(batchingTargetsMutex);
+
+    for (std::vector<RenderTarget*>::iterator it = batchingTargets.begin(); it != batchingTargets.end(); ++it)
+    {
+        if (((*it)->m_batch.texture == &texture) && !(*it)->m_batch.vertices.empty())
+            (*it)->flush();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics = Statistics();
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    // Pending primitives must be rendered with SFML's states
+    flush();
+
     if (setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -317,16 +565,20 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        // The core profile has no attribute and matrix stacks, SFML's states are simply set again
+        if (!m_coreRenderer)
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -336,18 +588,31 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    // Pending primitives must be rendered before the user's states are restored
+    flush();
+
     if (setActive(true))
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
-        #endif
+        if (m_coreRenderer)
+        {
+            // Leave the program and vertex array bindings clean for the user's code,
+            // they will be restored by the next draw
+            m_coreRenderer->unbind();
+            m_cache.glStatesSet = false;
+        }
+        else
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPopClientAttrib());
+                glCheck(glPopAttrib());
+            #endif
+        }
     }
 }
 
@@ -363,37 +628,64 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
-        // Make sure that the texture unit which is active is the number 0
-        if (GLEXT_multitexture)
+        // Select the rendering backend the first time the states are set in this context
+        if (!m_cache.glStatesSet && !m_coreRenderer && priv::CoreRenderer::isCoreContext())
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
-            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            m_coreRenderer = new priv::CoreRenderer;
+            if (!m_coreRenderer->create())
+            {
+                err() << "Failed to create the core profile renderer, nothing will be drawn" << std::endl;
+                delete m_coreRenderer;
+                m_coreRenderer = NULL;
+            }
         }
 
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        if (m_coreRenderer)
+        {
+            // Define the default OpenGL states, the rest is handled by the built-in program
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glEnable(GL_BLEND));
+            m_coreRenderer->bind();
+        }
+        else
+        {
+            // Stream dynamic vertices through a ring buffer instead of client-side arrays
+            if (!m_cache.glStatesSet && !m_streamBuffer && priv::StreamBuffer::isAvailable())
+                m_streamBuffer = new priv::StreamBuffer;
+
+            // Make sure that the texture unit which is active is the number 0
+            if (GLEXT_multitexture)
+            {
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+                glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            }
+
+            // Define the default OpenGL states
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glEnable(GL_BLEND));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
         applyTexture(NULL);
-        if (shaderAvailable)
+        if (shaderAvailable && !m_coreRenderer)
             applyShader(NULL);
 
         m_cache.useVertexCache = false;
 
         // Set the default view
-        setView(getView());
+        m_cache.viewChanged = true;
     }
 }
 
@@ -407,6 +699,12 @@ void RenderTarget::initialize()
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
+
+    // The context may have changed, the rendering backend will be selected again
+    delete m_coreRenderer;
+    m_coreRenderer = NULL;
+    delete m_streamBuffer;
+    m_streamBuffer = NULL;
 }
 
 
@@ -419,11 +717,18 @@ void RenderTarget::applyCurrentView()
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    if (m_coreRenderer)
+    {
+        m_coreRenderer->setProjectionMatrix(m_view.getTransform().getMatrix());
+    }
+    else
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
 
     m_cache.viewChanged = false;
 }
@@ -480,16 +785,51 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
-    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
-    // current mode (for optimization purpose, since it's the most used)
-    glCheck(glLoadMatrixf(transform.getMatrix()));
+    if (m_coreRenderer)
+    {
+        m_coreRenderer->setModelViewMatrix(transform.getMatrix());
+    }
+    else
+    {
+        // No need to call glMatrixMode(GL_MODELVIEW), it is always the
+        // current mode (for optimization purpose, since it's the most used)
+        glCheck(glLoadMatrixf(transform.getMatrix()));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    if (m_coreRenderer)
+    {
+        // Same texture matrix as Texture::bind(texture, Texture::Pixels)
+        GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
+                              0.f, 1.f, 0.f, 0.f,
+                              0.f, 0.f, 1.f, 0.f,
+                              0.f, 0.f, 0.f, 1.f};
+
+        GLuint textureId = 0;
+        if (texture && texture->m_texture)
+        {
+            textureId = texture->m_texture;
+            matrix[0] = 1.f / texture->m_actualSize.x;
+            matrix[5] = 1.f / texture->m_actualSize.y;
+
+            // If pixels are flipped we must invert the Y axis
+            if (texture->m_pixelsFlipped)
+            {
+                matrix[5] = -matrix[5];
+                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+            }
+        }
+
+        m_coreRenderer->setTexture(textureId, matrix);
+    }
+    else
+    {
+        Texture::bind(texture, Texture::Pixels);
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
 }
@@ -498,9 +838,248 @@ void RenderTarget::applyTexture(const Texture* texture)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
+    if (m_coreRenderer)
+    {
+        // sf::Shader is built on the compatibility profile, draws use the built-in program instead;
+        // it has its own mode for the distance field glyphs of fonts
+        bool distanceField = shader && Font::isDistanceFieldShader(shader);
+        m_coreRenderer->setDistanceField(distanceField);
+
+        static bool warned = false;
+        if (shader && !distanceField && !warned)
+        {
+            err() << "sf::Shader is not supported by the core profile renderer, the default shader is used instead" << std::endl;
+            warned = true;
+        }
+
+        return;
+    }
+
     Shader::bind(shader);
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // Since vertices are transformed, we must use an identity transform to render them
+    if (useVertexCache)
+    {
+        if (!m_cache.useVertexCache)
+            applyTransform(Transform::Identity);
+    }
+    else
+    {
+        applyTransform(states.transform);
+    }
+
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupVertices(const Vertex* vertices, std::size_t vertexCount, bool stream)
+{
+    if (m_coreRenderer)
+    {
+        // The core profile backend always streams the vertices to its own buffer
+        m_coreRenderer->setVertices(vertices);
+        m_statistics.bytesStreamed += vertexCount * sizeof(Vertex);
+    }
+    else if (stream && m_streamBuffer)
+    {
+        bool stalled = false;
+        std::size_t offset = m_streamBuffer->upload(vertices, vertexCount * sizeof(Vertex), stalled);
+
+        // The pointers capture the bound buffer, it can be unbound right away
+        const char* data = reinterpret_cast<const char*>(offset);
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+        m_statistics.bytesStreamed += vertexCount * sizeof(Vertex);
+        if (stalled)
+            m_statistics.streamStalls++;
+    }
+    else
+    {
+        const char* data = reinterpret_cast<const char*>(vertices);
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::usesCoreProfile()
+{
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    return m_coreRenderer != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount)
+{
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
+
+    // Draw the primitives
+    if (m_coreRenderer)
+    {
+        m_coreRenderer->drawPrimitives(type, firstVertex, vertexCount);
+    }
+    else if (instanceCount == 1)
+    {
+        glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+    }
+    else
+    {
+    #ifndef SFML_OPENGL_ES
+        glCheck(GLEXT_glDrawArraysInstanced(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount)));
+    #endif
+    }
+
+    // Update the statistics
+    m_statistics.drawCalls++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
+    // Unbind the shader, if any
+    if (states.shader)
+        applyShader(NULL);
+
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::appendToBatch(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    PrimitiveType batchType = getBatchPrimitiveType(type);
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+
+    // Flush the pending primitives if they can't be merged with the new ones
+    if (!m_batch.vertices.empty() &&
+        ((batchType != m_batch.type) || (textureId != m_batch.textureId) || (states.blendMode != m_batch.blendMode)))
+        flush();
+
+    m_batch.type      = batchType;
+    m_batch.blendMode = states.blendMode;
+    m_batch.texture   = states.texture;
+    m_batch.textureId = textureId;
+
+    // Convert connected primitives to independent ones
+    std::vector<Vertex>& batch = m_batch.vertices;
+    std::size_t first = batch.size();
+    switch (type)
+    {
+        case Points:
+        case Lines:
+        case Triangles:
+        {
+            batch.insert(batch.end(), vertices, vertices + vertexCount);
+            break;
+        }
+
+        case LineStrip:
+        {
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                batch.push_back(vertices[i - 1]);
+                batch.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        case TriangleStrip:
+        {
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                // Keep the winding of the strip's triangles consistent
+                std::size_t a = (i % 2 == 0) ? i - 2 : i - 1;
+                std::size_t b = (i % 2 == 0) ? i - 1 : i - 2;
+                batch.push_back(vertices[a]);
+                batch.push_back(vertices[b]);
+                batch.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        case TriangleFan:
+        {
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                batch.push_back(vertices[0]);
+                batch.push_back(vertices[i - 1]);
+                batch.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            for (std::size_t i = 3; i < vertexCount; i += 4)
+            {
+                static const std::size_t indices[] = {0, 1, 2, 0, 2, 3};
+                for (std::size_t j = 0; j < 6; ++j)
+                {
+                    const Vertex& vertex = vertices[i - 3 + indices[j]];
+                    batch.push_back(vertex);
+                }
+            }
+            break;
+        }
+    }
+
+    // Pre-transform the new vertices
+    if (batch.size() > first)
+        states.transform.transformPoints(&batch[first].position, sizeof(Vertex),
+                                         &batch[first].position, sizeof(Vertex), batch.size() - first);
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::Statistics::Statistics() :
+drawsSubmitted(0),
+drawCalls     (0),
+bytesStreamed (0),
+streamStalls  (0)
+{
+}
+
 } // namespace sf
 
 
@@ -539,4 +1118,12 @@ void RenderTarget::applyShader(const Shader* shader)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, draws without shader are pre-transformed
+//   and accumulated as long as they share the same texture
+//   and blend mode. Strips, fans and quads are converted to
+//   independent primitives so that any number of entities
+//   can be merged, and the whole batch is rendered with a
+//   single draw call when the states change.
+//
 ////////////////////////////////////////////////////////////
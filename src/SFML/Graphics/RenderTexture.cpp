@@ -133,6 +133,9 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Render the pending batched primitives first
+    flush();
+
     // Update the target texture
     if (setActive(true))
     {
@@ -27,6 +27,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/ReadbackTicket.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
 
 
 namespace sf
@@ -80,6 +82,7 @@ Image RenderWindow::capture() const
 {
     Vector2u windowSize = getSize();
 
+    // The texture update renders the pending batched primitives before copying the pixels
     Texture texture;
     texture.create(windowSize.x, windowSize.y);
     texture.update(*this);
@@ -88,6 +91,31 @@ Image RenderWindow::capture() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderWindow::captureAsync(ReadbackTicket& ticket)
+{
+    if (!ReadbackTicket::isAvailable())
+        return false;
+
+    // The pending batched primitives must be in the framebuffer
+    RenderTarget::flush();
+
+    if (!setActive(true))
+        return false;
+
+    Vector2u windowSize = getSize();
+    if (!ticket.beginRead(windowSize.x * windowSize.y * 4))
+        return false;
+
+    // OpenGL rows go from bottom to top, the ticket flips them when they are retrieved
+    glCheck(glReadPixels(0, 0, windowSize.x, windowSize.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+    ticket.endRead(windowSize, windowSize.x * 4, true);
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
@@ -103,4 +131,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Render the pending batched primitives before swapping the buffers
+    RenderTarget::flush();
+}
+
 } // namespace sf
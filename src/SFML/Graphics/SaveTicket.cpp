@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SaveTicket.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SaveTicket::SaveTicket() :
+m_thread  (&SaveTicket::run, this),
+m_filename(),
+m_pixels  (),
+m_size    (0, 0),
+m_mutex   (),
+m_pending (false),
+m_done    (false),
+m_success (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SaveTicket::~SaveTicket()
+{
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SaveTicket::isPending() const
+{
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SaveTicket::isReady() const
+{
+    Lock lock(m_mutex);
+
+    return !m_pending || m_done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SaveTicket::wait()
+{
+    if (!m_pending)
+        return false;
+
+    m_thread.wait();
+    m_pending = false;
+
+    // Release the copy of the pixels, which may be large
+    std::vector<Uint8>().swap(m_pixels);
+
+    return m_success;
+}
+
+
+////////////////////////////////////////////////////////////
+void SaveTicket::launch(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+{
+    wait();
+
+    m_filename = filename;
+    m_pixels   = pixels;
+    m_size     = size;
+    m_pending  = true;
+    m_done     = false;
+    m_success  = false;
+
+    priv::ImageLoader::prepareThreads();
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void SaveTicket::run()
+{
+    bool success = priv::ImageLoader::getInstance().saveImageToFile(m_filename, m_pixels, m_size);
+
+    Lock lock(m_mutex);
+    m_success = success;
+    m_done    = true;
+}
+
+} // namespace sf
@@ -0,0 +1,375 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker() :
+m_size     (0, 0),
+m_skyline  (),
+m_freeRects(),
+m_usedArea (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::reset(unsigned int width, unsigned int height)
+{
+    m_size = Vector2u(width, height);
+    m_skyline.clear();
+    m_freeRects.clear();
+    m_usedArea = 0;
+
+    if (width > 0)
+    {
+        Node node = {0, 0, width};
+        m_skyline.push_back(node);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::grow(unsigned int width, unsigned int height)
+{
+    // The new columns start empty, at the bottom of the area
+    if (width > m_size.x)
+    {
+        if (!m_skyline.empty() && (m_skyline.back().y == 0))
+        {
+            m_skyline.back().width += width - m_size.x;
+        }
+        else
+        {
+            Node node = {m_size.x, 0, width - m_size.x};
+            m_skyline.push_back(node);
+        }
+
+        m_size.x = width;
+    }
+
+    // Rows are added on top of the skyline, nothing else to update
+    if (height > m_size.y)
+        m_size.y = height;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insert(unsigned int width, unsigned int height, IntRect& rect)
+{
+    if ((width == 0) || (height == 0))
+        return false;
+
+    // Filling the holes first keeps the skyline as low as possible
+    if (!insertInFreeRects(width, height, rect) && !insertOnSkyline(width, height, rect))
+        return false;
+
+    m_usedArea += static_cast<Uint64>(width) * height;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::free(const IntRect& rect)
+{
+    m_usedArea -= std::min(m_usedArea, static_cast<Uint64>(rect.width) * rect.height);
+
+    // When everything has been freed, start again from an empty area
+    if (m_usedArea == 0)
+        reset(m_size.x, m_size.y);
+    else
+        addFreeRect(rect);
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::occupy(const IntRect& rect)
+{
+    if ((rect.width <= 0) || (rect.height <= 0))
+        return;
+
+    unsigned int left   = rect.left;
+    unsigned int right  = rect.left + rect.width;
+    unsigned int bottom = rect.top + rect.height;
+
+    // Split the segments at the edges of the rectangle, and raise the ones under it
+    std::vector<Node> skyline;
+    for (std::vector<Node>::const_iterator it = m_skyline.begin(); it != m_skyline.end(); ++it)
+    {
+        unsigned int start = it->x;
+        unsigned int end   = it->x + it->width;
+
+        if (start < left)
+        {
+            Node node = {start, it->y, std::min(end, left) - start};
+            skyline.push_back(node);
+        }
+
+        if ((end > left) && (start < right))
+        {
+            unsigned int x = std::max(start, left);
+            Node node = {x, std::max(it->y, bottom), std::min(end, right) - x};
+            skyline.push_back(node);
+        }
+
+        if (end > right)
+        {
+            unsigned int x = std::max(start, right);
+            Node node = {x, it->y, end - x};
+            skyline.push_back(node);
+        }
+    }
+
+    m_skyline.swap(skyline);
+    mergeSkyline();
+
+    m_usedArea += static_cast<Uint64>(rect.width) * rect.height;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SkylinePacker::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SkylinePacker::getUsedArea() const
+{
+    return m_usedArea;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insertInFreeRects(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Find the free rectangle that leaves the smallest leftover on its shorter side
+    std::size_t best = m_freeRects.size();
+    unsigned int bestScore = 0;
+    for (std::size_t i = 0; i < m_freeRects.size(); ++i)
+    {
+        const IntRect& freeRect = m_freeRects[i];
+        if ((width > static_cast<unsigned int>(freeRect.width)) || (height > static_cast<unsigned int>(freeRect.height)))
+            continue;
+
+        unsigned int score = std::min(freeRect.width - width, freeRect.height - height);
+        if ((best == m_freeRects.size()) || (score < bestScore))
+        {
+            best = i;
+            bestScore = score;
+        }
+    }
+
+    if (best == m_freeRects.size())
+        return false;
+
+    IntRect freeRect = m_freeRects[best];
+    m_freeRects.erase(m_freeRects.begin() + best);
+
+    rect = IntRect(freeRect.left, freeRect.top, width, height);
+
+    // Split the rest of the free rectangle along its shorter leftover,
+    // so that the larger of the two remaining parts is as big as possible
+    int w = static_cast<int>(width);
+    int h = static_cast<int>(height);
+    IntRect right;
+    IntRect bottom;
+    if (freeRect.width - w < freeRect.height - h)
+    {
+        right  = IntRect(freeRect.left + w, freeRect.top, freeRect.width - w, h);
+        bottom = IntRect(freeRect.left, freeRect.top + h, freeRect.width, freeRect.height - h);
+    }
+    else
+    {
+        right  = IntRect(freeRect.left + w, freeRect.top, freeRect.width - w, freeRect.height);
+        bottom = IntRect(freeRect.left, freeRect.top + h, w, freeRect.height - h);
+    }
+
+    addFreeRect(right);
+    addFreeRect(bottom);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insertOnSkyline(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Find the position where the top of the rectangle is the lowest (bottom-left rule)
+    std::size_t best = m_skyline.size();
+    unsigned int bestBottom = 0;
+    unsigned int bestTop = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        unsigned int top = 0;
+        if (!fit(i, width, height, top))
+            continue;
+
+        if ((best == m_skyline.size()) || (top + height < bestBottom))
+        {
+            best = i;
+            bestBottom = top + height;
+            bestTop = top;
+        }
+    }
+
+    if (best == m_skyline.size())
+        return false;
+
+    unsigned int left = m_skyline[best].x;
+    unsigned int right = left + width;
+    rect = IntRect(left, bestTop, width, height);
+
+    // Keep the gaps between the skyline and the rectangle as free rectangles
+    for (std::size_t i = best; (i < m_skyline.size()) && (m_skyline[i].x < right); ++i)
+    {
+        const Node& node = m_skyline[i];
+        if (node.y < bestTop)
+        {
+            unsigned int gapWidth = std::min(node.x + node.width, right) - node.x;
+            addFreeRect(IntRect(node.x, node.y, gapWidth, bestTop - node.y));
+        }
+    }
+
+    // Insert the new segment, and shrink or remove the ones it covers
+    Node node = {left, bestTop + height, width};
+    m_skyline.insert(m_skyline.begin() + best, node);
+
+    std::size_t i = best + 1;
+    while ((i < m_skyline.size()) && (m_skyline[i].x < right))
+    {
+        unsigned int end = m_skyline[i].x + m_skyline[i].width;
+        if (end <= right)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+        else
+        {
+            m_skyline[i].width = end - right;
+            m_skyline[i].x = right;
+            break;
+        }
+    }
+
+    mergeSkyline();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& top) const
+{
+    if (m_skyline[index].x + width > m_size.x)
+        return false;
+
+    // The rectangle rests on the highest segment it spans
+    top = 0;
+    unsigned int covered = 0;
+    for (std::size_t i = index; covered < width; ++i)
+    {
+        top = std::max(top, m_skyline[i].y);
+        if (top + height > m_size.y)
+            return false;
+
+        covered += m_skyline[i].width;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::mergeSkyline()
+{
+    for (std::size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::addFreeRect(IntRect rect)
+{
+    if ((rect.width <= 0) || (rect.height <= 0))
+        return;
+
+    // Merge with the free rectangles that share a whole edge with this one
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (std::vector<IntRect>::iterator it = m_freeRects.begin(); it != m_freeRects.end(); ++it)
+        {
+            bool sameRow    = (it->top == rect.top) && (it->height == rect.height);
+            bool sameColumn = (it->left == rect.left) && (it->width == rect.width);
+
+            if (sameRow && ((it->left + it->width == rect.left) || (rect.left + rect.width == it->left)))
+            {
+                rect.left = std::min(rect.left, it->left);
+                rect.width += it->width;
+            }
+            else if (sameColumn && ((it->top + it->height == rect.top) || (rect.top + rect.height == it->top)))
+            {
+                rect.top = std::min(rect.top, it->top);
+                rect.height += it->height;
+            }
+            else
+            {
+                continue;
+            }
+
+            m_freeRects.erase(it);
+            merged = true;
+            break;
+        }
+    }
+
+    m_freeRects.push_back(rect);
+}
+
+} // namespace priv
+
+} // namespace sf
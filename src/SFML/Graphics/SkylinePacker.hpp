@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SKYLINEPACKER_HPP
+#define SFML_SKYLINEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Packer of rectangles into a 2D area
+///
+/// This is an evolution of the row-based packing of the glyph
+/// pages of sf::Font. Instead of rows of fixed height, the
+/// packer tracks the skyline formed by the top edges of the
+/// rectangles already placed, and puts new rectangles at the
+/// lowest position where they fit. The gaps left under the
+/// skyline and the freed rectangles are kept in a list of free
+/// rectangles, which are filled first.
+///
+////////////////////////////////////////////////////////////
+class SkylinePacker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty packer of size 0x0.
+    ///
+    ////////////////////////////////////////////////////////////
+    SkylinePacker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the packer to an empty area
+    ///
+    /// \param width  Width of the area
+    /// \param height Height of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the area, keeping the rectangles already placed
+    ///
+    /// Sizes smaller than the current ones are ignored.
+    ///
+    /// \param width  New width of the area
+    /// \param height New height of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a place for a new rectangle
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the placed rectangle
+    ///
+    /// \return True if the rectangle was placed, false if there's not enough room
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back the space of a placed rectangle
+    ///
+    /// \param rect Rectangle returned by insert
+    ///
+    ////////////////////////////////////////////////////////////
+    void free(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a rectangle as used, without looking for a place
+    ///
+    /// This is used to rebuild the state of a packer from the
+    /// rectangles it placed. The skyline is raised above the
+    /// rectangle; the gaps left under it are not reused.
+    ///
+    /// \param rect Rectangle to mark as used
+    ///
+    ////////////////////////////////////////////////////////////
+    void occupy(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area
+    ///
+    /// \return Size of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area covered by the placed rectangles
+    ///
+    /// \return Number of pixels covered by the placed rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getUsedArea() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Node
+    {
+        unsigned int x;     ///< Left of the segment
+        unsigned int y;     ///< Height of the skyline along the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a rectangle in one of the free rectangles
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the placed rectangle
+    ///
+    /// \return True if a free rectangle was large enough
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insertInFreeRects(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a rectangle on top of the skyline
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the placed rectangle
+    ///
+    /// \return True if the rectangle fits under the top of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insertOnSkyline(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute where a rectangle would be placed on a skyline segment
+    ///
+    /// \param index  Index of the first segment under the rectangle
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param top    Receives the top of the rectangle
+    ///
+    /// \return True if the rectangle fits at this position
+    ///
+    ////////////////////////////////////////////////////////////
+    bool fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& top) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Merge the neighbour segments of the skyline that have the same height
+    ///
+    ////////////////////////////////////////////////////////////
+    void mergeSkyline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a free rectangle, merging it with its neighbours when possible
+    ///
+    /// \param rect Rectangle to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void addFreeRect(IntRect rect);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u             m_size;      ///< Size of the area
+    std::vector<Node>    m_skyline;   ///< Segments of the skyline, from left to right
+    std::vector<IntRect> m_freeRects; ///< Free rectangles under the skyline
+    Uint64               m_usedArea;  ///< Area covered by the placed rectangles
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SKYLINEPACKER_HPP
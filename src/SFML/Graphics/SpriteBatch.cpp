@@ -0,0 +1,527 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cmath>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+#endif
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Unit quad instantiated for every sprite, its corners are scaled by the instance's texture rect
+    const sf::Vertex quadVertices[4] =
+    {
+        sf::Vertex(sf::Vector2f(0.f, 0.f)),
+        sf::Vertex(sf::Vector2f(0.f, 1.f)),
+        sf::Vertex(sf::Vector2f(1.f, 0.f)),
+        sf::Vertex(sf::Vector2f(1.f, 1.f))
+    };
+
+    // Names of the per-instance attributes, in the order of SpriteBatch::m_attributes
+    const char* attributeNames[4] =
+    {
+        "instanceTransformX",
+        "instanceTransformY",
+        "instanceColor",
+        "instanceTextureRect"
+    };
+
+    const char* vertexShaderSource =
+        "attribute vec3 instanceTransformX;\n"
+        "attribute vec3 instanceTransformY;\n"
+        "attribute vec4 instanceColor;\n"
+        "attribute vec4 instanceTextureRect;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 corner = gl_Vertex.xy;\n"
+        "    vec3 point = vec3(corner * abs(instanceTextureRect.zw), 1.0);\n"
+        "    vec4 position = vec4(dot(instanceTransformX, point), dot(instanceTransformY, point), 0.0, 1.0);\n"
+        "    vec4 texCoords = vec4(instanceTextureRect.xy + corner * instanceTextureRect.zw, 0.0, 1.0);\n"
+        "\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * position;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * texCoords;\n"
+        "    gl_FrontColor = instanceColor;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "uniform sampler2D texture;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture          (NULL),
+m_textureRect      (),
+m_transforms       (),
+m_colors           (),
+m_textureRects     (),
+m_instancingEnabled(true),
+m_shader           (NULL),
+m_shaderFailed     (false),
+m_vertices         ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) :
+m_texture          (NULL),
+m_textureRect      (),
+m_transforms       (),
+m_colors           (),
+m_textureRects     (),
+m_instancingEnabled(true),
+m_shader           (NULL),
+m_shaderFailed     (false),
+m_vertices         ()
+{
+    setTexture(texture, true);
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const SpriteBatch& copy) :
+Drawable           (),
+GlResource         (),
+m_texture          (copy.m_texture),
+m_textureRect      (copy.m_textureRect),
+m_transforms       (copy.m_transforms),
+m_colors           (copy.m_colors),
+m_textureRects     (copy.m_textureRects),
+m_instancingEnabled(copy.m_instancingEnabled),
+m_shader           (NULL),
+m_shaderFailed     (false),
+m_vertices         ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::~SpriteBatch()
+{
+    delete m_shader;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch& SpriteBatch::operator =(const SpriteBatch& right)
+{
+    // The instancing shader is not copied, each batch creates its own on first use
+    m_texture           = right.m_texture;
+    m_textureRect       = right.m_textureRect;
+    m_transforms        = right.m_transforms;
+    m_colors            = right.m_colors;
+    m_textureRects      = right.m_textureRects;
+    m_instancingEnabled = right.m_instancingEnabled;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+        setTextureRect(IntRect(0, 0, texture.getSize().x, texture.getSize().y));
+
+    // Assign the new texture
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(const IntRect& rectangle)
+{
+    m_textureRect = rectangle;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& SpriteBatch::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getInstanceCount() const
+{
+    return m_colors.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::resize(std::size_t instanceCount)
+{
+    std::size_t count = getInstanceCount();
+
+    // std::vector::resize never releases memory, so shrinking is cheap
+    m_colors.resize(instanceCount, Color::White);
+    m_textureRects.resize(instanceCount, FloatRect(m_textureRect));
+    m_transforms.resize(instanceCount * 6);
+
+    for (std::size_t i = count; i < instanceCount; ++i)
+        setTransform(i, Transform::Identity);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_transforms.clear();
+    m_colors.clear();
+    m_textureRects.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::append(const Transform& transform, const Color& color)
+{
+    append(transform, color, m_textureRect);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::append(const Transform& transform, const Color& color, const IntRect& textureRect)
+{
+    m_colors.push_back(color);
+    m_textureRects.push_back(FloatRect(textureRect));
+    m_transforms.resize(m_transforms.size() + 6);
+
+    setTransform(m_colors.size() - 1, transform);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTransform(std::size_t index, const Transform& transform)
+{
+    // Keep the two first rows of the 3x3 affine matrix
+    const float* matrix = transform.getMatrix();
+    float* row = &m_transforms[index * 6];
+
+    row[0] = matrix[0];
+    row[1] = matrix[4];
+    row[2] = matrix[12];
+    row[3] = matrix[1];
+    row[4] = matrix[5];
+    row[5] = matrix[13];
+}
+
+
+////////////////////////////////////////////////////////////
+float* SpriteBatch::getTransforms()
+{
+    return m_transforms.empty() ? NULL : &m_transforms[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const float* SpriteBatch::getTransforms() const
+{
+    return m_transforms.empty() ? NULL : &m_transforms[0];
+}
+
+
+////////////////////////////////////////////////////////////
+Color* SpriteBatch::getColors()
+{
+    return m_colors.empty() ? NULL : &m_colors[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color* SpriteBatch::getColors() const
+{
+    return m_colors.empty() ? NULL : &m_colors[0];
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect* SpriteBatch::getTextureRects()
+{
+    return m_textureRects.empty() ? NULL : &m_textureRects[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect* SpriteBatch::getTextureRects() const
+{
+    return m_textureRects.empty() ? NULL : &m_textureRects[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setInstancingEnabled(bool enabled)
+{
+    m_instancingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingEnabled() const
+{
+    return m_instancingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingAvailable()
+{
+    // Instancing requires a shader to read the per-instance attributes
+    if (!Shader::isAvailable())
+        return false;
+
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_draw_instanced && GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_colors.empty())
+        return;
+
+    states.texture = m_texture;
+
+    // Custom shaders can't read the per-instance attributes, the instances must be expanded in that case
+    if (m_instancingEnabled && !states.shader && isInstancingAvailable())
+    {
+        if (drawInstanced(target, states))
+            return;
+    }
+
+    drawExpanded(target, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::drawInstanced(RenderTarget& target, RenderStates states) const
+{
+#ifndef SFML_OPENGL_ES
+
+    // The core profile backend has its own program, the instancing shader cannot be used there
+    if (!target.setActive(true) || target.usesCoreProfile())
+        return false;
+
+    if (!ensureShader())
+        return false;
+
+    // Render the pending batched primitives before the per-instance attributes are enabled
+    target.flush();
+
+    if (!target.setActive(true))
+        return false;
+
+    // Source the per-instance attributes directly from our arrays, advancing once per instance
+    const GLuint transformX  = static_cast<GLuint>(m_attributes[0]);
+    const GLuint transformY  = static_cast<GLuint>(m_attributes[1]);
+    const GLuint color       = static_cast<GLuint>(m_attributes[2]);
+    const GLuint textureRect = static_cast<GLuint>(m_attributes[3]);
+    const GLsizei transformStride = 6 * sizeof(float);
+
+    glCheck(GLEXT_glVertexAttribPointer(transformX, 3, GL_FLOAT, GL_FALSE, transformStride, &m_transforms[0]));
+    glCheck(GLEXT_glVertexAttribPointer(transformY, 3, GL_FLOAT, GL_FALSE, transformStride, &m_transforms[3]));
+    glCheck(GLEXT_glVertexAttribPointer(color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Color), &m_colors[0]));
+    glCheck(GLEXT_glVertexAttribPointer(textureRect, 4, GL_FLOAT, GL_FALSE, sizeof(FloatRect), &m_textureRects[0]));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        glCheck(GLEXT_glEnableVertexAttribArray(static_cast<GLuint>(m_attributes[i])));
+        glCheck(GLEXT_glVertexAttribDivisor(static_cast<GLuint>(m_attributes[i]), 1));
+    }
+
+    states.shader = m_shader;
+    target.drawInstances(quadVertices, 4, TriangleStrip, getInstanceCount(), states);
+
+    // Restore the default state of the attributes, they would otherwise leak into regular draws
+    if (target.setActive(true))
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            glCheck(GLEXT_glVertexAttribDivisor(static_cast<GLuint>(m_attributes[i]), 0));
+            glCheck(GLEXT_glDisableVertexAttribArray(static_cast<GLuint>(m_attributes[i])));
+        }
+    }
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::drawExpanded(RenderTarget& target, const RenderStates& states) const
+{
+    std::size_t count = getInstanceCount();
+
+    // Two triangles per instance
+    m_vertices.resize(count * 6);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* t = &m_transforms[i * 6];
+        const FloatRect& rect = m_textureRects[i];
+        const Color& color = m_colors[i];
+
+        float width  = std::abs(rect.width);
+        float height = std::abs(rect.height);
+        float left   = rect.left;
+        float top    = rect.top;
+        float right  = left + rect.width;
+        float bottom = top + rect.height;
+
+        // Transformed corners of the quad: top-left, bottom-left, top-right, bottom-right
+        Vector2f topLeft    (t[2], t[5]);
+        Vector2f bottomLeft (t[1] * height + t[2], t[4] * height + t[5]);
+        Vector2f topRight   (t[0] * width + t[2], t[3] * width + t[5]);
+        Vector2f bottomRight(t[0] * width + t[1] * height + t[2], t[3] * width + t[4] * height + t[5]);
+
+        Vertex* vertices = &m_vertices[i * 6];
+        vertices[0] = Vertex(topLeft, color, Vector2f(left, top));
+        vertices[1] = Vertex(bottomLeft, color, Vector2f(left, bottom));
+        vertices[2] = Vertex(topRight, color, Vector2f(right, top));
+        vertices[3] = vertices[2];
+        vertices[4] = vertices[1];
+        vertices[5] = Vertex(bottomRight, color, Vector2f(right, bottom));
+    }
+
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::ensureShader() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_shader)
+        return true;
+
+    // Don't try again if the shader couldn't be created before
+    if (m_shaderFailed)
+        return false;
+
+    m_shader = new Shader;
+    if (!m_shader->loadFromMemory(vertexShaderSource, fragmentShaderSource))
+    {
+        err() << "Failed to create the instancing shader of sf::SpriteBatch, falling back to CPU expansion" << std::endl;
+        delete m_shader;
+        m_shader = NULL;
+        m_shaderFailed = true;
+        return false;
+    }
+
+    m_shader->setUniform("texture", Shader::CurrentTexture);
+
+    TransientContextLock lock;
+
+    // Retrieve the locations of the per-instance attributes
+    GLEXT_GLhandle program = castToGlHandle(m_shader->getNativeHandle());
+    for (int i = 0; i < 4; ++i)
+    {
+        glCheck(m_attributes[i] = GLEXT_glGetAttribLocation(program, attributeNames[i]));
+        if (m_attributes[i] == -1)
+        {
+            err() << "Failed to find the attribute \"" << attributeNames[i] << "\" in the instancing shader of sf::SpriteBatch" << std::endl;
+            delete m_shader;
+            m_shader = NULL;
+            m_shaderFailed = true;
+            return false;
+        }
+    }
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+} // namespace sf
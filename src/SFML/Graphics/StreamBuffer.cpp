@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Initial size of each segment of the ring, in bytes
+    const std::size_t initialSegmentSize = 256 * 1024;
+
+    // Time given to the GPU at each attempt when waiting for a fence, in nanoseconds
+    const sf::Uint64 fenceWaitTimeout = 1000000;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+StreamBuffer::StreamBuffer() :
+m_buffer     (0),
+m_mode       (Orphaning),
+m_segmentSize(0),
+m_segment    (0),
+m_offset     (0),
+m_mapping    (NULL)
+{
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+        m_fences[i] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+StreamBuffer::~StreamBuffer()
+{
+    TransientContextLock contextLock;
+
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamBuffer::isAvailable()
+{
+    return VertexBuffer::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamBuffer::upload(const void* data, std::size_t size, bool& stalled)
+{
+    stalled = false;
+
+    // Make room for the data if a segment is too small to hold it
+    if (!m_buffer || (size > m_segmentSize))
+        allocate(std::max(size, std::max(m_segmentSize * 2, initialSegmentSize)));
+    else
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    if (m_mode == Orphaning)
+    {
+        // Without fences the whole buffer is a single region, the driver
+        // gives us fresh storage when it is full so that we never wait
+        if (m_offset + size > m_segmentSize * SegmentCount)
+        {
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, m_segmentSize * SegmentCount, NULL, GLEXT_GL_STREAM_DRAW));
+            m_offset = 0;
+        }
+
+        std::size_t offset = m_offset;
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, offset, size, data));
+        m_offset += size;
+
+        return offset;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Move to the next segment if the data doesn't fit in the current one
+    if (m_offset + size > (m_segment + 1) * m_segmentSize)
+        stalled = nextSegment();
+
+    std::size_t offset = m_offset;
+    m_offset += size;
+
+    if (m_mode == Persistent)
+    {
+        // The mapping is coherent, writes are visible to the draw calls issued after them
+        std::memcpy(m_mapping + offset, data, size);
+    }
+    else
+    {
+        // The fences already guarantee that the GPU doesn't read this range anymore
+        void* destination = NULL;
+        glCheck(destination = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, offset, size, GLEXT_GL_MAP_WRITE_BIT |
+                                                                                          GLEXT_GL_MAP_INVALIDATE_RANGE_BIT |
+                                                                                          GLEXT_GL_MAP_UNSYNCHRONIZED_BIT));
+        if (destination)
+        {
+            std::memcpy(destination, data, size);
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+        }
+        else
+        {
+            glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, offset, size, data));
+        }
+    }
+
+    return offset;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamBuffer::allocate(std::size_t segmentSize)
+{
+    release();
+
+    GLuint buffer = 0;
+    glCheck(GLEXT_glGenBuffers(1, &buffer));
+    m_buffer = static_cast<unsigned int>(buffer);
+
+    m_segmentSize = segmentSize;
+    m_segment = 0;
+    m_offset = 0;
+
+    std::size_t capacity = m_segmentSize * SegmentCount;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+#ifndef SFML_OPENGL_ES
+
+    // Prefer a persistent mapping, then unsynchronized mappings, both rely on fences
+    if (GLEXT_buffer_storage && GLEXT_map_buffer_range && GLEXT_sync)
+    {
+        const GLbitfield flags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_PERSISTENT_BIT | GLEXT_GL_MAP_COHERENT_BIT;
+        glCheck(GLEXT_glBufferStorage(GLEXT_GL_ARRAY_BUFFER, capacity, NULL, flags));
+
+        void* mapping = NULL;
+        glCheck(mapping = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, 0, capacity, flags));
+        m_mapping = static_cast<char*>(mapping);
+
+        if (m_mapping)
+        {
+            m_mode = Persistent;
+            return;
+        }
+
+        // The storage of the buffer is immutable now, start again with a new one
+        err() << "Failed to map the stream buffer persistently, falling back to unsynchronized mappings" << std::endl;
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    }
+
+    m_mode = (GLEXT_map_buffer_range && GLEXT_sync) ? Unsynchronized : Orphaning;
+
+#else
+
+    m_mode = Orphaning;
+
+#endif
+
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, capacity, NULL, GLEXT_GL_STREAM_DRAW));
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamBuffer::release()
+{
+#ifndef SFML_OPENGL_ES
+
+    // The GPU may still be reading the buffer, but deleting it only
+    // releases our name: the driver keeps the storage alive until then
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fences[i])));
+            m_fences[i] = NULL;
+        }
+    }
+
+#endif
+
+    if (m_buffer)
+    {
+        // Deleting the buffer also unmaps it
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        m_buffer = 0;
+    }
+
+    m_mapping = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamBuffer::nextSegment()
+{
+    bool stalled = false;
+
+#ifndef SFML_OPENGL_ES
+
+    // Protect the segment we leave from being overwritten while it is read
+    glCheck(m_fences[m_segment] = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    m_segment = (m_segment + 1) % SegmentCount;
+    m_offset = m_segment * m_segmentSize;
+
+    // Wait until the GPU is done with the segment we enter
+    GLEXT_GLsync fence = static_cast<GLEXT_GLsync>(m_fences[m_segment]);
+    if (fence)
+    {
+        GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+        glCheck(status = GLEXT_glClientWaitSync(fence, 0, 0));
+
+        if (status == GLEXT_GL_TIMEOUT_EXPIRED)
+        {
+            stalled = true;
+
+            // Flush the pending commands once, so that the fence is eventually reached
+            GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+            while (status == GLEXT_GL_TIMEOUT_EXPIRED)
+            {
+                glCheck(status = GLEXT_glClientWaitSync(fence, flags, fenceWaitTimeout));
+                flags = 0;
+            }
+        }
+
+        glCheck(GLEXT_glDeleteSync(fence));
+        m_fences[m_segment] = NULL;
+    }
+
+#endif
+
+    return stalled;
+}
+
+} // namespace priv
+
+} // namespace sf
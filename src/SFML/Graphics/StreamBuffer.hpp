@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMBUFFER_HPP
+#define SFML_STREAMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Ring buffer used to stream dynamic vertices
+///        to graphics memory
+///
+/// The buffer is split into three segments that are filled
+/// one after the other. When a segment is left, a fence is
+/// inserted after the draw calls that read from it, and the
+/// segment is only written again once the GPU has passed
+/// that fence. Uploads therefore never allocate and only
+/// wait for the GPU if it is more than two segments behind.
+///
+/// Depending on the available extensions, the buffer is
+/// mapped persistently once (ARB_buffer_storage), mapped
+/// without synchronization for every upload
+/// (ARB_map_buffer_range), or, without sync objects, updated
+/// with glBufferSubData and orphaned when it is full.
+///
+/// The stream buffer must be used in the context in which
+/// it was created.
+///
+////////////////////////////////////////////////////////////
+class StreamBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports stream buffers
+    ///
+    /// \return True if stream buffers can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy data to the stream buffer
+    ///
+    /// The buffer is left bound to GL_ARRAY_BUFFER, so that
+    /// vertex pointers can be set up with the returned offset.
+    ///
+    /// \param data    Pointer to the data to copy
+    /// \param size    Size of the data, in bytes
+    /// \param stalled Set to true if the upload had to wait for the GPU
+    ///
+    /// \return Offset of the copied data in the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t upload(const void* data, std::size_t size, bool& stalled);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Strategies used to update the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Mode
+    {
+        Persistent,     ///< Mapped once with ARB_buffer_storage, synchronized with fences
+        Unsynchronized, ///< Mapped for every upload without implicit synchronization, synchronized with fences
+        Orphaning       ///< Updated with glBufferSubData, orphaned when full
+    };
+
+    enum {SegmentCount = 3};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief (Re)create the buffer storage
+    ///
+    /// \param segmentSize Size of each segment, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void allocate(std::size_t segmentSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the buffer storage and the pending fences
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fence the current segment and move to the next one
+    ///
+    /// \return True if the GPU was still reading the next segment
+    ///
+    ////////////////////////////////////////////////////////////
+    bool nextSegment();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;                 ///< OpenGL identifier of the buffer
+    Mode         m_mode;                   ///< Strategy used to update the buffer
+    std::size_t  m_segmentSize;            ///< Size of each segment, in bytes
+    std::size_t  m_segment;                ///< Index of the segment being filled
+    std::size_t  m_offset;                 ///< Write cursor, in bytes from the start of the buffer
+    char*        m_mapping;                ///< Address of the persistent mapping, if any
+    void*        m_fences[SegmentCount];   ///< Fences protecting the segments still read by the GPU
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMBUFFER_HPP
@@ -26,50 +26,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextGeometry.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <cmath>
 
 
-namespace
-{
-    // Add an underline or strikethrough line to the vertex array
-    void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
-    {
-        float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
-        float bottom = top + std::floor(thickness + 0.5f);
-
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-    }
-
-    // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italic, float outlineThickness = 0)
-    {
-        float left   = glyph.bounds.left;
-        float top    = glyph.bounds.top;
-        float right  = glyph.bounds.left + glyph.bounds.width;
-        float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-        float u1 = static_cast<float>(glyph.textureRect.left);
-        float v1 = static_cast<float>(glyph.textureRect.top);
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
-
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
-    }
-}
-
-
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -84,7 +46,10 @@ m_outlineThickness  (0),
 m_vertices          (Triangles),
 m_outlineVertices   (Triangles),
 m_bounds            (),
-m_geometryNeedUpdate(false)
+m_geometryNeedUpdate(false),
+m_fontGeneration    (0),
+m_lines             (),
+m_validLength       (0)
 {
 
 }
@@ -102,7 +67,10 @@ m_outlineThickness  (0),
 m_vertices          (Triangles),
 m_outlineVertices   (Triangles),
 m_bounds            (),
-m_geometryNeedUpdate(true)
+m_geometryNeedUpdate(true),
+m_fontGeneration    (0),
+m_lines             (),
+m_validLength       (0)
 {
 
 }
@@ -111,11 +79,42 @@ m_geometryNeedUpdate(true)
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
-    if (m_string != string)
+    // Find the first modified character
+    std::size_t count  = std::min(m_string.getSize(), string.getSize());
+    std::size_t prefix = 0;
+    while ((prefix < count) && (m_string[prefix] == string[prefix]))
+        ++prefix;
+
+    // Nothing to do if the strings are identical
+    if ((prefix == m_string.getSize()) && (prefix == string.getSize()))
+        return;
+
+    if (prefix < string.getSize())
     {
-        m_string = string;
+        // Characters were modified or appended
+        m_validLength = std::min(m_validLength, prefix);
+    }
+    else if (prefix > 0)
+    {
+        // Characters were removed from the end: recompute the last
+        // remaining one, so that the geometry which followed it is removed
+        m_validLength = std::min(m_validLength, prefix - 1);
+    }
+    else
+    {
+        // The string is now empty
         m_geometryNeedUpdate = true;
     }
+
+    m_string = string;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::appendString(const String& string)
+{
+    // The geometry of the current string remains valid
+    m_string += string;
 }
 
 
@@ -334,6 +333,11 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
 
+        // Distance field glyphs are rendered by the font's shader, unless another one is provided
+        // (core profile targets recognize it and switch their built-in shader to distance field mode)
+        if (!states.shader && m_font->isDistanceFieldEnabled())
+            states.shader = m_font->getDistanceFieldShader();
+
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
             target.draw(m_outlineVertices, states);
@@ -346,21 +350,33 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
-    // Do nothing, if geometry has not changed
-    if (!m_geometryNeedUpdate)
+    // Glyphs evicted from the font texture must be reloaded
+    bool glyphsEvicted = m_font && (m_font->getGlyphGeneration(m_characterSize) != m_fontGeneration);
+
+    // Do nothing, if geometry has not changed and the font glyphs are still valid
+    if (!m_geometryNeedUpdate && !glyphsEvicted && (m_validLength == m_string.getSize()))
         return;
 
-    // Mark geometry as updated
-    m_geometryNeedUpdate = false;
+    // Recompute the whole geometry if any attribute has changed, otherwise
+    // only recompute the lines following the first modified character
+    if (m_geometryNeedUpdate || glyphsEvicted)
+        m_lines.clear();
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    // Mark geometry as updated, remembering the first character to recompute
+    std::size_t modified = m_validLength;
+    m_geometryNeedUpdate = false;
+    m_validLength = m_string.getSize();
 
     // No font or text: nothing to draw
     if (!m_font || m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_bounds = FloatRect();
+        m_lines.clear();
+        m_fontGeneration = m_font ? m_font->getGlyphGeneration(m_characterSize) : 0;
         return;
+    }
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
@@ -379,16 +395,45 @@ void Text::ensureGeometryUpdate() const
     // Precompute the variables needed by the algorithm
     float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
+
+    // Start from the first line, or resume from the line containing the first modified character
+    bool resumed = !m_lines.empty();
+    if (!resumed)
+    {
+        LineState first;
+        first.index              = 0;
+        first.vertexCount        = 0;
+        first.outlineVertexCount = 0;
+        first.y                  = static_cast<float>(m_characterSize);
+        first.prevChar           = 0;
+        first.minX               = static_cast<float>(m_characterSize);
+        first.minY               = static_cast<float>(m_characterSize);
+        first.maxX               = 0.f;
+        first.maxY               = 0.f;
+        m_lines.push_back(first);
+    }
+    else
+    {
+        while (m_lines.back().index > modified)
+            m_lines.pop_back();
+    }
+
+    // Remove the geometry of the lines that will be recomputed
+    LineState line = m_lines.back();
+    m_vertices.resize(line.vertexCount);
+    m_outlineVertices.resize(line.outlineVertexCount);
+
+    float x = 0.f;
+    float y = line.y;
+    float minX = line.minX;
+    float minY = line.minY;
+    float maxX = line.maxX;
+    float maxY = line.maxY;
+    Uint32 prevChar = line.prevChar;
+    Uint64 generation = m_font->getGlyphGeneration(m_characterSize);
 
     // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    for (std::size_t i = line.index; i < m_string.getSize(); ++i)
     {
         Uint32 curChar = m_string[i];
 
@@ -399,19 +444,19 @@ void Text::ensureGeometryUpdate() const
         // If we're using the underlined style and there's a new line, draw a line
         if (underlined && (curChar == L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+            priv::addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+                priv::addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
         }
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (strikeThrough && (curChar == L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+            priv::addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+                priv::addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
         }
 
         // Handle special characters
@@ -432,6 +477,22 @@ void Text::ensureGeometryUpdate() const
             maxX = std::max(maxX, x);
             maxY = std::max(maxY, y);
 
+            // Save the state of the layout at the start of the new line
+            if (curChar == '\n')
+            {
+                LineState next;
+                next.index              = i + 1;
+                next.vertexCount        = m_vertices.getVertexCount();
+                next.outlineVertexCount = m_outlineVertices.getVertexCount();
+                next.y                  = y;
+                next.prevChar           = prevChar;
+                next.minX               = minX;
+                next.minY               = minY;
+                next.maxX               = maxX;
+                next.maxY               = maxY;
+                m_lines.push_back(next);
+            }
+
             // Next glyph, no need to create a quad for whitespace
             continue;
         }
@@ -448,7 +509,7 @@ void Text::ensureGeometryUpdate() const
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
             // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italic, m_outlineThickness);
+            priv::addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italic, m_outlineThickness);
 
             // Update the current bounds with the outlined glyph bounds
             minX = std::min(minX, x + left   - italic * bottom - m_outlineThickness);
@@ -461,7 +522,7 @@ void Text::ensureGeometryUpdate() const
         const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italic);
+        priv::addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italic);
 
         // Update the current bounds with the non outlined glyph bounds
         if (m_outlineThickness == 0)
@@ -484,19 +545,19 @@ void Text::ensureGeometryUpdate() const
     // If we're using the underlined style, add the last line
     if (underlined && (x > 0))
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+        priv::addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
         if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+            priv::addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
     }
 
     // If we're using the strike through style, add the last line across all characters
     if (strikeThrough && (x > 0))
     {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        priv::addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
         if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+            priv::addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
     }
 
     // Update the bounding rectangle
@@ -504,6 +565,18 @@ void Text::ensureGeometryUpdate() const
     m_bounds.top = minY;
     m_bounds.width = maxX - minX;
     m_bounds.height = maxY - minY;
+
+    // If loading the new glyphs evicted older ones, the geometry of
+    // the lines that were kept may refer to them: recompute everything
+    if (resumed && (m_font->getGlyphGeneration(m_characterSize) != generation))
+    {
+        m_geometryNeedUpdate = true;
+        ensureGeometryUpdate();
+        return;
+    }
+
+    // Save the generation of the glyphs, now that they are all loaded
+    m_fontGeneration = m_font->getGlyphGeneration(m_characterSize);
 }
 
 } // namespace sf
@@ -0,0 +1,500 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Copy the local vertices of a run into the vertices of its page, applying the run's transform
+    void copyVertices(const sf::VertexArray& source, const sf::Transform& transform, std::vector<sf::Vertex>& destination, std::size_t offset)
+    {
+        for (std::size_t i = 0; i < source.getVertexCount(); ++i)
+        {
+            sf::Vertex& vertex = destination[offset + i];
+            vertex = source[i];
+            vertex.position = transform.transformPoint(vertex.position);
+        }
+    }
+
+    // Upload a range of the vertices of a page to its vertex buffer, if vertex buffers are supported
+    void uploadVertices(sf::VertexBuffer& buffer, const std::vector<sf::Vertex>& vertices, std::size_t offset, std::size_t count)
+    {
+        if ((count == 0) || !sf::VertexBuffer::isAvailable())
+            return;
+
+        // The buffer never shrinks, so that pages which grow and shrink don't reallocate it
+        if (offset + count > buffer.getVertexCount())
+            buffer.create(offset + count);
+
+        buffer.update(&vertices[offset], count, static_cast<unsigned int>(offset));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch() :
+m_font (NULL),
+m_runs (),
+m_pages()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch(const Font& font) :
+m_font (&font),
+m_runs (),
+m_pages()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch(const TextBatch& copy) :
+Drawable(),
+m_font  (copy.m_font),
+m_runs  (copy.m_runs),
+m_pages ()
+{
+    // The vertex buffers are not copied, the pages are rebuilt on first draw
+    resetPages();
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch& TextBatch::operator =(const TextBatch& right)
+{
+    m_font = right.m_font;
+    m_runs = right.m_runs;
+    resetPages();
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+
+        for (RunList::iterator it = m_runs.begin(); it != m_runs.end(); ++it)
+            it->text.setFont(font);
+
+        // The pages depend on the font, they are all rebuilt
+        resetPages();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* TextBatch::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::getRunCount() const
+{
+    return m_runs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::append(const String& string, const Vector2f& position, unsigned int characterSize, const Color& color)
+{
+    m_runs.push_back(Run());
+
+    Text& text = m_runs.back().text;
+    if (m_font)
+        text.setFont(*m_font);
+    text.setString(string);
+    text.setPosition(position);
+    text.setCharacterSize(characterSize);
+    text.setFillColor(color);
+
+    return m_runs.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+    m_runs.clear();
+    m_pages.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setString(std::size_t index, const String& string)
+{
+    m_runs[index].text.setString(string);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const String& TextBatch::getString(std::size_t index) const
+{
+    return m_runs[index].text.getString();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_runs[index].text.setPosition(position);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& TextBatch::getPosition(std::size_t index) const
+{
+    return m_runs[index].text.getPosition();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setCharacterSize(std::size_t index, unsigned int size)
+{
+    m_runs[index].text.setCharacterSize(size);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextBatch::getCharacterSize(std::size_t index) const
+{
+    return m_runs[index].text.getCharacterSize();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setStyle(std::size_t index, Uint32 style)
+{
+    m_runs[index].text.setStyle(style);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TextBatch::getStyle(std::size_t index) const
+{
+    return m_runs[index].text.getStyle();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setFillColor(std::size_t index, const Color& color)
+{
+    m_runs[index].text.setFillColor(color);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TextBatch::getFillColor(std::size_t index) const
+{
+    return m_runs[index].text.getFillColor();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setOutlineColor(std::size_t index, const Color& color)
+{
+    m_runs[index].text.setOutlineColor(color);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TextBatch::getOutlineColor(std::size_t index) const
+{
+    return m_runs[index].text.getOutlineColor();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setOutlineThickness(std::size_t index, float thickness)
+{
+    m_runs[index].text.setOutlineThickness(thickness);
+    m_runs[index].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextBatch::getOutlineThickness(std::size_t index) const
+{
+    return m_runs[index].text.getOutlineThickness();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getRunBounds(std::size_t index) const
+{
+    return m_runs[index].text.getGlobalBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_font || m_runs.empty())
+        return;
+
+    ensureGeometryUpdate();
+
+    // Distance field glyphs are rendered by the font's shader, unless another one is provided
+    // (core profile targets recognize it and switch their built-in shader to distance field mode)
+    if (!states.shader && m_font->isDistanceFieldEnabled())
+        states.shader = m_font->getDistanceFieldShader();
+
+    bool useBuffers = VertexBuffer::isAvailable();
+
+    // Draw the outlines of all the pages first, then their fill
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        {
+            const Page& page = it->second;
+            const std::vector<Vertex>& vertices = (pass == 0) ? page.outlineVertices : page.vertices;
+            const VertexBuffer&        buffer   = (pass == 0) ? page.outlineBuffer : page.buffer;
+
+            if (vertices.empty())
+                continue;
+
+            states.texture = &m_font->getTexture(it->first);
+
+            if (useBuffers)
+                target.draw(buffer, 0, vertices.size(), states);
+            else
+                target.draw(&vertices[0], vertices.size(), Triangles, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::ensureGeometryUpdate() const
+{
+    if (!m_font)
+        return;
+
+    // Loading the glyphs of a run may evict glyphs used by runs already
+    // processed; in that case a second pass rebuilds the affected pages
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        // Runs whose glyphs were evicted from the font texture must be rebuilt
+        for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        {
+            Page& page = it->second;
+            Uint64 generation = m_font->getGlyphGeneration(it->first);
+            if (generation != page.generation)
+            {
+                for (std::vector<std::size_t>::const_iterator run = page.runs.begin(); run != page.runs.end(); ++run)
+                    m_runs[*run].dirty = true;
+                page.generation = generation;
+            }
+        }
+
+        // Recompute the geometry of the modified runs, moving them to their new page if needed
+        for (std::size_t i = 0; i < m_runs.size(); ++i)
+        {
+            Run& run = m_runs[i];
+
+            unsigned int key = getPageKey(run.text.getCharacterSize());
+            if (!run.paged || (run.page != key))
+            {
+                if (run.paged)
+                {
+                    Page& previous = m_pages[run.page];
+                    previous.runs.erase(std::find(previous.runs.begin(), previous.runs.end(), i));
+                    previous.layoutDirty = true;
+                }
+
+                PageTable::iterator it = m_pages.find(key);
+                if (it == m_pages.end())
+                {
+                    it = m_pages.insert(std::make_pair(key, Page())).first;
+                    it->second.generation = m_font->getGlyphGeneration(key);
+                }
+
+                it->second.runs.push_back(i);
+                it->second.layoutDirty = true;
+
+                run.page  = key;
+                run.paged = true;
+                run.dirty = true;
+            }
+
+            if (!run.dirty)
+                continue;
+
+            run.text.ensureGeometryUpdate();
+            run.dirty = false;
+
+            // If the run keeps the same number of vertices, it can be updated in place
+            Page& page = m_pages[run.page];
+            if ((run.text.m_vertices.getVertexCount() == run.vertexCount) &&
+                (run.text.m_outlineVertices.getVertexCount() == run.outlineVertexCount))
+                page.updated.push_back(i);
+            else
+                page.layoutDirty = true;
+        }
+
+        // Update the vertices of the pages
+        bool valid = true;
+        for (PageTable::iterator it = m_pages.begin(); it != m_pages.end();)
+        {
+            Page& page = it->second;
+
+            // Remove the pages which are no longer used
+            if (page.runs.empty())
+            {
+                m_pages.erase(it++);
+                continue;
+            }
+
+            if (page.layoutDirty)
+            {
+                // Some runs were added, removed or resized: rebuild all the vertices of the page
+                std::size_t count = 0;
+                std::size_t outlineCount = 0;
+                for (std::vector<std::size_t>::const_iterator index = page.runs.begin(); index != page.runs.end(); ++index)
+                {
+                    Run& run = m_runs[*index];
+                    run.offset             = count;
+                    run.vertexCount        = run.text.m_vertices.getVertexCount();
+                    run.outlineOffset      = outlineCount;
+                    run.outlineVertexCount = run.text.m_outlineVertices.getVertexCount();
+                    count += run.vertexCount;
+                    outlineCount += run.outlineVertexCount;
+                }
+
+                page.vertices.resize(count);
+                page.outlineVertices.resize(outlineCount);
+                for (std::vector<std::size_t>::const_iterator index = page.runs.begin(); index != page.runs.end(); ++index)
+                {
+                    const Run& run = m_runs[*index];
+                    copyVertices(run.text.m_vertices, run.text.getTransform(), page.vertices, run.offset);
+                    copyVertices(run.text.m_outlineVertices, run.text.getTransform(), page.outlineVertices, run.outlineOffset);
+                }
+
+                uploadVertices(page.buffer, page.vertices, 0, page.vertices.size());
+                uploadVertices(page.outlineBuffer, page.outlineVertices, 0, page.outlineVertices.size());
+            }
+            else
+            {
+                // Only overwrite the vertices of the modified runs
+                for (std::vector<std::size_t>::const_iterator index = page.updated.begin(); index != page.updated.end(); ++index)
+                {
+                    const Run& run = m_runs[*index];
+                    copyVertices(run.text.m_vertices, run.text.getTransform(), page.vertices, run.offset);
+                    copyVertices(run.text.m_outlineVertices, run.text.getTransform(), page.outlineVertices, run.outlineOffset);
+
+                    uploadVertices(page.buffer, page.vertices, run.offset, run.vertexCount);
+                    uploadVertices(page.outlineBuffer, page.outlineVertices, run.outlineOffset, run.outlineVertexCount);
+                }
+            }
+
+            page.updated.clear();
+            page.layoutDirty = false;
+
+            if (m_font->getGlyphGeneration(it->first) != page.generation)
+                valid = false;
+
+            ++it;
+        }
+
+        if (valid)
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextBatch::getPageKey(unsigned int characterSize) const
+{
+    // Same rule as the font: all the sizes share the same texture if the atlas is shared
+    if (m_font->isSharedAtlasEnabled() || m_font->isDistanceFieldEnabled())
+        return 0;
+
+    return characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::resetPages()
+{
+    for (RunList::iterator it = m_runs.begin(); it != m_runs.end(); ++it)
+    {
+        it->paged = false;
+        it->dirty = true;
+    }
+
+    m_pages.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::Run::Run() :
+text              (),
+page              (0),
+paged             (false),
+dirty             (true),
+offset            (0),
+vertexCount       (0),
+outlineOffset     (0),
+outlineVertexCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::Page::Page() :
+runs           (),
+updated        (),
+vertices       (),
+outlineVertices(),
+buffer         (Triangles, VertexBuffer::Dynamic),
+outlineBuffer  (Triangles, VertexBuffer::Dynamic),
+generation     (0),
+layoutDirty    (true)
+{
+}
+
+} // namespace sf
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTGEOMETRY_HPP
+#define SFML_TEXTGEOMETRY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Add an underline or strike through line to a vertex array
+///
+/// The line is textured with the white square stored at the
+/// top-left corner of the font textures.
+///
+/// \param vertices         Vertex array receiving the triangles of the line
+/// \param lineLength       Length of the line
+/// \param lineTop          Vertical position of the baseline
+/// \param color            Color of the line
+/// \param offset           Offset of the line from the baseline
+/// \param thickness        Thickness of the line
+/// \param outlineThickness Thickness of the outline around the line
+///
+////////////////////////////////////////////////////////////
+void addLine(VertexArray& vertices, float lineLength, float lineTop, const Color& color, float offset, float thickness, float outlineThickness = 0);
+
+////////////////////////////////////////////////////////////
+/// \brief Add a glyph quad to a vertex array
+///
+/// \param vertices         Vertex array receiving the triangles of the glyph
+/// \param position         Position of the glyph's origin on the baseline
+/// \param color            Color of the glyph
+/// \param glyph            Glyph to add
+/// \param italic           Shear applied to make the glyph italic (0 for none)
+/// \param outlineThickness Thickness of the outline of the glyph
+///
+////////////////////////////////////////////////////////////
+void addGlyphQuad(VertexArray& vertices, Vector2f position, const Color& color, const Glyph& glyph, float italic, float outlineThickness = 0);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTGEOMETRY_HPP
@@ -0,0 +1,433 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextLayout.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextGeometry.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout() :
+m_string          (),
+m_font            (NULL),
+m_characterSize   (30),
+m_style           (Text::Regular),
+m_wrapWidth       (0),
+m_positions       (),
+m_lines           (),
+m_width           (0),
+m_layoutNeedUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout(const String& string, const Font& font, unsigned int characterSize) :
+m_string          (string),
+m_font            (&font),
+m_characterSize   (characterSize),
+m_style           (Text::Regular),
+m_wrapWidth       (0),
+m_positions       (),
+m_lines           (),
+m_width           (0),
+m_layoutNeedUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setString(const String& string)
+{
+    if (m_string != string)
+    {
+        m_string = string;
+        m_layoutNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        m_layoutNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        m_layoutNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setStyle(Uint32 style)
+{
+    if (m_style != style)
+    {
+        m_style = style;
+        m_layoutNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setWrapWidth(float width)
+{
+    if (m_wrapWidth != width)
+    {
+        m_wrapWidth = width;
+        m_layoutNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const String& TextLayout::getString() const
+{
+    return m_string;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* TextLayout::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextLayout::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TextLayout::getStyle() const
+{
+    return m_style;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextLayout::getWrapWidth() const
+{
+    return m_wrapWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getLineCount() const
+{
+    ensureLayoutUpdate();
+
+    return m_lines.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getLineStart(std::size_t line) const
+{
+    ensureLayoutUpdate();
+
+    return (line < m_lines.size()) ? m_lines[line].start : m_string.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+float TextLayout::getLineWidth(std::size_t line) const
+{
+    ensureLayoutUpdate();
+
+    return (line < m_lines.size()) ? m_lines[line].width : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::findLine(std::size_t index) const
+{
+    ensureLayoutUpdate();
+
+    // Find the last line starting at or before the character
+    std::size_t first = 0;
+    std::size_t last  = m_lines.size();
+    while (last - first > 1)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        if (m_lines[middle].start <= index)
+            first = middle;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::findLineAt(float y) const
+{
+    ensureLayoutUpdate();
+
+    float spacing = getLineSpacing();
+    if ((spacing <= 0) || (y < 0))
+        return 0;
+
+    return std::min(static_cast<std::size_t>(y / spacing), m_lines.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TextLayout::findCharacterPos(std::size_t index) const
+{
+    ensureLayoutUpdate();
+
+    // Adjust the index if it's out of range
+    if (index > m_string.getSize())
+        index = m_string.getSize();
+
+    return Vector2f(m_positions[index], findLine(index) * getLineSpacing());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::findCharacterIndex(const Vector2f& position) const
+{
+    ensureLayoutUpdate();
+
+    // The cursor can be placed anywhere on the line, but not after
+    // the character that ends it (new line or whitespace of a wrap)
+    std::size_t line  = findLineAt(position.y);
+    std::size_t start = m_lines[line].start;
+    std::size_t end   = (line + 1 < m_lines.size()) ? m_lines[line + 1].start - 1 : m_string.getSize();
+
+    // Find the first character boundary at the right of the position
+    const float* positions = &m_positions[0];
+    std::size_t index = std::lower_bound(positions + start, positions + end + 1, position.x) - positions;
+    if (index == start)
+        return start;
+    if (index > end)
+        return end;
+
+    // Return the closest of the two boundaries around the position
+    return (position.x - positions[index - 1] < positions[index] - position.x) ? index - 1 : index;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextLayout::getBounds() const
+{
+    ensureLayoutUpdate();
+
+    return FloatRect(0, 0, m_width, m_lines.size() * getLineSpacing());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::getVertices(VertexArray& vertices, std::size_t firstLine, std::size_t lineCount, const Color& color, float outlineThickness) const
+{
+    ensureLayoutUpdate();
+
+    if (!m_font || (firstLine >= m_lines.size()))
+        return;
+
+    // Compute values related to the text style
+    bool  bold               = (m_style & Text::Bold) != 0;
+    bool  underlined         = (m_style & Text::Underlined) != 0;
+    bool  strikeThrough      = (m_style & Text::StrikeThrough) != 0;
+    float italic             = (m_style & Text::Italic) ? 0.208f : 0.f; // 12 degrees
+    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
+    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+    float spacing            = getLineSpacing();
+
+    // Compute the location of the strike through dynamically, like sf::Text
+    float strikeThroughOffset = 0;
+    if (strikeThrough)
+    {
+        FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
+        strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+    }
+
+    std::size_t lastLine = std::min(firstLine + lineCount, m_lines.size());
+    for (std::size_t line = firstLine; line < lastLine; ++line)
+    {
+        std::size_t start = m_lines[line].start;
+        std::size_t end   = (line + 1 < m_lines.size()) ? m_lines[line + 1].start : m_string.getSize();
+        float       y     = line * spacing + static_cast<float>(m_characterSize);
+
+        // Add a quad for each visible character of the line
+        for (std::size_t i = start; i < end; ++i)
+        {
+            Uint32 curChar = m_string[i];
+            if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
+                continue;
+
+            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold, outlineThickness);
+            priv::addGlyphQuad(vertices, Vector2f(m_positions[i], y), color, glyph, italic, outlineThickness);
+        }
+
+        // Add the underline and strike through of the line
+        float width = m_lines[line].width;
+        if (underlined && (width > 0))
+            priv::addLine(vertices, width, y, color, underlineOffset, underlineThickness, outlineThickness);
+        if (strikeThrough && (width > 0))
+            priv::addLine(vertices, width, y, color, strikeThroughOffset, underlineThickness, outlineThickness);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::ensureLayoutUpdate() const
+{
+    if (!m_layoutNeedUpdate)
+        return;
+
+    m_layoutNeedUpdate = false;
+
+    // Start with an empty first line
+    std::size_t count = m_string.getSize();
+    m_positions.assign(count + 1, 0.f);
+    m_lines.clear();
+    m_width = 0;
+
+    Line firstLine = {0, 0.f};
+    m_lines.push_back(firstLine);
+
+    if (!m_font)
+        return;
+
+    bool  bold   = (m_style & Text::Bold) != 0;
+    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+
+    float       x          = 0.f; // Position of the next character
+    float       lineWidth  = 0.f; // Width of the current line, without trailing whitespace
+    std::size_t breakIndex = 0;   // Index of the character following the last whitespace of the line (0 if none)
+    float       breakWidth = 0.f; // Width of the line before this whitespace
+    Uint32      prevChar   = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint32 curChar = m_string[i];
+
+        // Apply the kerning offset
+        x += m_font->getKerning(prevChar, curChar, m_characterSize);
+        prevChar = curChar;
+        m_positions[i] = x;
+
+        // Start a new line after a new line character
+        if (curChar == '\n')
+        {
+            m_lines.back().width = lineWidth;
+            m_width = std::max(m_width, lineWidth);
+
+            Line line = {i + 1, 0.f};
+            m_lines.push_back(line);
+
+            x = 0.f;
+            lineWidth = 0.f;
+            breakIndex = 0;
+            prevChar = 0;
+            continue;
+        }
+
+        bool whitespace = (curChar == ' ') || (curChar == '\t');
+        float advance;
+        switch (curChar)
+        {
+            case ' ':  advance = hspace;     break;
+            case '\t': advance = hspace * 4; break;
+            default:   advance = m_font->getGlyph(curChar, m_characterSize, bold).advance; break;
+        }
+
+        // Wrap the line if the character doesn't fit
+        std::size_t lineStart = m_lines.back().start;
+        if ((m_wrapWidth > 0) && !whitespace && (x + advance > m_wrapWidth) && (i > lineStart))
+        {
+            // Break after the last whitespace, or before the character if the word is too long
+            bool afterWhitespace = (breakIndex > lineStart);
+            std::size_t breakAt = afterWhitespace ? breakIndex : i;
+
+            m_lines.back().width = afterWhitespace ? breakWidth : lineWidth;
+            m_width = std::max(m_width, m_lines.back().width);
+
+            Line line = {breakAt, 0.f};
+            m_lines.push_back(line);
+
+            // Move the characters which follow the break to the new line
+            float offset = m_positions[breakAt];
+            for (std::size_t j = breakAt; j <= i; ++j)
+                m_positions[j] -= offset;
+
+            x -= offset;
+            lineWidth = (breakAt < i) ? lineWidth - offset : 0.f;
+            breakIndex = 0;
+        }
+
+        // Advance to the next character
+        x += advance;
+        if (whitespace)
+        {
+            breakIndex = i + 1;
+            breakWidth = lineWidth;
+        }
+        else
+        {
+            lineWidth = x;
+        }
+    }
+
+    m_positions[count] = x;
+    m_lines.back().width = lineWidth;
+    m_width = std::max(m_width, lineWidth);
+}
+
+
+////////////////////////////////////////////////////////////
+float TextLayout::getLineSpacing() const
+{
+    return m_font ? m_font->getLineSpacing(m_characterSize) : 0.f;
+}
+
+} // namespace sf
@@ -29,11 +29,14 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/ReadbackTicket.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -42,6 +45,7 @@ namespace
 {
     sf::Mutex idMutex;
     sf::Mutex maximumSizeMutex;
+    sf::Mutex asyncUpdateMutex;
 
     // Thread-safe unique identifier generator,
     // is used for states cache (see RenderTarget)
@@ -69,7 +73,9 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelBuffer  (0),
+m_uploadFence  (NULL)
 {
 }
 
@@ -85,7 +91,9 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelBuffer  (0),
+m_uploadFence  (NULL)
 {
     if (copy.m_texture)
         loadFromImage(copy.copyToImage());
@@ -103,6 +111,25 @@ Texture::~Texture()
         GLuint texture = static_cast<GLuint>(m_texture);
         glCheck(glDeleteTextures(1, &texture));
     }
+
+    // Destroy the objects of the asynchronous updates
+    if (m_pixelBuffer || m_uploadFence)
+    {
+        TransientContextLock lock;
+
+    #ifndef SFML_OPENGL_ES
+
+        if (m_uploadFence)
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_uploadFence)));
+
+        if (m_pixelBuffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_pixelBuffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+
+    #endif
+    }
 }
 
 
@@ -205,6 +232,109 @@ bool Texture::create(unsigned int width, unsigned int height)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::resize(unsigned int width, unsigned int height, const Color& color)
+{
+    if (!m_texture)
+    {
+        err() << "Failed to resize texture, it has not been created" << std::endl;
+        return false;
+    }
+
+    if (m_fboAttachment)
+    {
+        err() << "Failed to resize texture, it is owned by a render-texture" << std::endl;
+        return false;
+    }
+
+    // Create the resized texture with the same settings
+    Texture resized;
+    resized.m_isSmooth   = m_isSmooth;
+    resized.m_sRgb       = m_sRgb;
+    resized.m_isRepeated = m_isRepeated;
+    if (!resized.create(width, height))
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    bool copied = false;
+    if (GLEXT_framebuffer_object)
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        GLint previousFrameBuffer;
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+
+        GLuint frameBuffer = 0;
+        glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+        if (frameBuffer)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+
+            // Fill the resized texture with the color of the new pixels
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resized.m_texture, 0));
+            GLenum status;
+            glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+            if (status == GLEXT_GL_FRAMEBUFFER_COMPLETE)
+            {
+                GLfloat previousColor[4];
+                glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, previousColor));
+                glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+                glCheck(glClear(GL_COLOR_BUFFER_BIT));
+                glCheck(glClearColor(previousColor[0], previousColor[1], previousColor[2], previousColor[3]));
+
+                // Copy the current pixels from the framebuffer to the resized texture
+                glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
+                glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+                if (status == GLEXT_GL_FRAMEBUFFER_COMPLETE)
+                {
+                    // Flipped pixels have their top row at the end of the texture
+                    unsigned int copyWidth  = std::min(m_size.x, width);
+                    unsigned int copyHeight = std::min(m_size.y, height);
+                    unsigned int sourceY    = m_pixelsFlipped ? m_size.y - copyHeight : 0;
+                    unsigned int targetY    = m_pixelsFlipped ? height - copyHeight : 0;
+
+                    glCheck(glBindTexture(GL_TEXTURE_2D, resized.m_texture));
+                    glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, targetY, 0, sourceY, copyWidth, copyHeight));
+                    resized.m_pixelsFlipped = m_pixelsFlipped;
+                    copied = true;
+                }
+            }
+
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        }
+    }
+
+    if (!copied)
+    {
+        // Slow path: read the pixels back, and upload them again
+        Image image;
+        image.create(width, height, color);
+        image.copy(copyToImage(), 0, 0);
+        resized.update(image);
+    }
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    // Take the resized texture; the previous one is destroyed with it
+    std::swap(m_size,          resized.m_size);
+    std::swap(m_actualSize,    resized.m_actualSize);
+    std::swap(m_texture,       resized.m_texture);
+    std::swap(m_pixelsFlipped, resized.m_pixelsFlipped);
+    m_hasMipmap = false;
+    m_cacheId = getUniqueId();
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
@@ -386,6 +516,38 @@ Image Texture::copyToImage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::copyToImageAsync(ReadbackTicket& ticket) const
+{
+    if (!m_texture || !ReadbackTicket::isAvailable())
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Read the whole storage, padding and flipping are handled when the pixels are retrieved
+    if (!ticket.beginRead(m_actualSize.x * m_actualSize.y * 4))
+        return false;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+    ticket.endRead(m_size, m_actualSize.x * 4, m_pixelsFlipped);
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels)
 {
@@ -437,6 +599,147 @@ void Texture::update(const Image& image, unsigned int x, unsigned int y)
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (pixels && m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+
+    #ifndef SFML_OPENGL_ES
+
+        if (isAsyncUpdateAvailable())
+        {
+            if (!m_pixelBuffer)
+            {
+                GLuint buffer = 0;
+                glCheck(GLEXT_glGenBuffers(1, &buffer));
+                m_pixelBuffer = static_cast<unsigned int>(buffer);
+            }
+
+            // Orphan the previous storage: the driver keeps it until the pending transfer
+            // is done and gives us a fresh one, so that we never wait for the GPU here
+            GLsizeiptrARB size = static_cast<GLsizeiptrARB>(width) * height * 4;
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_pixelBuffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, size, NULL, GLEXT_GL_STREAM_DRAW));
+
+            void* destination = NULL;
+            glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+            if (destination)
+            {
+                std::memcpy(destination, pixels, static_cast<std::size_t>(size));
+                glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+            }
+            else
+            {
+                glCheck(GLEXT_glBufferSubData(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0, size, pixels));
+            }
+
+            // The source of the transfer is now the buffer, at offset 0
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+            // Replace the fence of the previous update, this one is signaled after it
+            if (GLEXT_sync)
+            {
+                if (m_uploadFence)
+                    glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_uploadFence)));
+
+                glCheck(m_uploadFence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            }
+        }
+        else
+
+    #endif
+
+        {
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+
+        // Unlike update(), no glFlush here: see flushUpdates()
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updateAsync(const Image& image, unsigned int x, unsigned int y)
+{
+    updateAsync(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isUpdateComplete() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_uploadFence)
+    {
+        TransientContextLock lock;
+
+        // Don't wait, only check the state of the fence; the pending commands
+        // are submitted if needed, otherwise the fence may never be reached
+        GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+        glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_uploadFence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+        if (status == GLEXT_GL_TIMEOUT_EXPIRED)
+            return false;
+
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_uploadFence)));
+        m_uploadFence = NULL;
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::flushUpdates()
+{
+    TransientContextLock lock;
+
+    glCheck(glFlush());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isAsyncUpdateAvailable()
+{
+    Lock lock(asyncUpdateMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object;
+    }
+
+    return available;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Window& window)
 {
@@ -450,6 +753,11 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    // The primitives still pending in the draw batch of a render window must be in its back-buffer
+    const RenderWindow* renderWindow = dynamic_cast<const RenderWindow*>(&window);
+    if (m_texture && renderWindow)
+        const_cast<RenderWindow*>(renderWindow)->flush();
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -703,6 +1011,8 @@ Texture& Texture::operator =(const Texture& right)
     std::swap(m_pixelsFlipped, temp.m_pixelsFlipped);
     std::swap(m_fboAttachment, temp.m_fboAttachment);
     std::swap(m_hasMipmap,     temp.m_hasMipmap);
+    std::swap(m_pixelBuffer,   temp.m_pixelBuffer);
+    std::swap(m_uploadFence,   temp.m_uploadFence);
     m_cacheId = getUniqueId();
 
     return *this;
@@ -0,0 +1,364 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    // Transparent pixels kept on the right and bottom of each image
+    const unsigned int padding = 1;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TextureAtlas::Page
+{
+    Texture             texture; ///< Texture containing the pixels of the images
+    priv::SkylinePacker packer;  ///< Placement of the images in the texture
+};
+
+
+////////////////////////////////////////////////////////////
+const TextureAtlas::Handle TextureAtlas::InvalidHandle = 0;
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas() :
+m_pages    (),
+m_entries  (),
+m_freeSlots(),
+m_count    (0),
+m_pageSize (1024),
+m_isSmooth (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::~TextureAtlas()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setPageSize(unsigned int size)
+{
+    m_pageSize = std::max(size, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getPageSize() const
+{
+    return m_pageSize;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::add(const Image& image, const IntRect& area)
+{
+    // Adjust the area to the image, the same way Texture::loadFromImage does
+    int imageWidth = static_cast<int>(image.getSize().x);
+    int imageHeight = static_cast<int>(image.getSize().y);
+
+    IntRect rectangle = area;
+    if ((rectangle.width == 0) || (rectangle.height == 0))
+        rectangle = IntRect(0, 0, imageWidth, imageHeight);
+    if (rectangle.left   < 0) rectangle.left = 0;
+    if (rectangle.top    < 0) rectangle.top  = 0;
+    if (rectangle.left + rectangle.width > imageWidth)  rectangle.width  = imageWidth - rectangle.left;
+    if (rectangle.top + rectangle.height > imageHeight) rectangle.height = imageHeight - rectangle.top;
+
+    if ((rectangle.width <= 0) || (rectangle.height <= 0))
+    {
+        err() << "Failed to add an image to the texture atlas, the image is empty" << std::endl;
+        return InvalidHandle;
+    }
+
+    unsigned int width = static_cast<unsigned int>(rectangle.width);
+    unsigned int height = static_cast<unsigned int>(rectangle.height);
+
+    // Find a page with enough room for the image and its padding
+    IntRect rect;
+    std::size_t pageIndex = 0;
+    while ((pageIndex < m_pages.size()) && !m_pages[pageIndex]->packer.insert(width + padding, height + padding, rect))
+        ++pageIndex;
+
+    if (pageIndex == m_pages.size())
+    {
+        // No room left: create a new page, large enough for the image
+        unsigned int maximumSize = Texture::getMaximumSize();
+        unsigned int pageWidth = std::min(std::max(m_pageSize, width + padding), maximumSize);
+        unsigned int pageHeight = std::min(std::max(m_pageSize, height + padding), maximumSize);
+
+        if ((width + padding > pageWidth) || (height + padding > pageHeight))
+        {
+            err() << "Failed to add an image to the texture atlas, its size (" << width << "x" << height << ") "
+                  << "exceeds the maximum texture size (" << maximumSize << "x" << maximumSize << ")" << std::endl;
+            return InvalidHandle;
+        }
+
+        // Start from transparent pixels, so that the padding doesn't leak garbage into smoothed images
+        Image pixels;
+        pixels.create(pageWidth, pageHeight, Color(255, 255, 255, 0));
+
+        Page* page = new Page;
+        if (!page->texture.loadFromImage(pixels))
+        {
+            err() << "Failed to add an image to the texture atlas, the page texture couldn't be created" << std::endl;
+            delete page;
+            return InvalidHandle;
+        }
+
+        page->texture.setSmooth(m_isSmooth);
+        page->packer.reset(pageWidth, pageHeight);
+        page->packer.insert(width + padding, height + padding, rect);
+        m_pages.push_back(page);
+    }
+
+    rect.width = rectangle.width;
+    rect.height = rectangle.height;
+
+    // Copy the pixels to the page
+    Texture& texture = m_pages[pageIndex]->texture;
+    if ((rectangle.width == imageWidth) && (rectangle.height == imageHeight))
+    {
+        texture.update(image, rect.left, rect.top);
+    }
+    else
+    {
+        std::vector<Uint8> pixels(width * height * 4);
+        const Uint8* source = image.getPixelsPtr() + (rectangle.left + rectangle.top * imageWidth) * 4;
+        for (unsigned int y = 0; y < height; ++y)
+            std::copy(source + y * imageWidth * 4, source + (y * imageWidth + width) * 4, &pixels[y * width * 4]);
+
+        texture.update(&pixels[0], width, height, rect.left, rect.top);
+    }
+
+    // Store the image in a free slot
+    std::size_t slot = m_entries.size();
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        Entry entry;
+        entry.generation = 0;
+        m_entries.push_back(entry);
+    }
+
+    Entry& entry = m_entries[slot];
+    entry.used = true;
+    entry.page = pageIndex;
+    entry.rect = rect;
+    ++m_count;
+
+    // Handles combine the index of the slot with its generation, so that
+    // the handles of removed images don't refer to the images that reuse their slot
+    return (static_cast<Handle>(entry.generation) << 32) | static_cast<Handle>(slot + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::addFromFile(const std::string& filename)
+{
+    Image image;
+    if (!image.loadFromFile(filename))
+        return InvalidHandle;
+
+    return add(image);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::remove(Handle handle)
+{
+    const Entry* found = findEntry(handle);
+    if (!found)
+        return;
+
+    std::size_t slot = static_cast<std::size_t>(found - &m_entries[0]);
+    Entry& entry = m_entries[slot];
+    Page& page = *m_pages[entry.page];
+
+    // Clear the pixels, the next image placed here may not cover all of them
+    unsigned int width = static_cast<unsigned int>(entry.rect.width);
+    unsigned int height = static_cast<unsigned int>(entry.rect.height);
+    std::vector<Uint8> transparent(width * height * 4, 0);
+    page.texture.update(&transparent[0], width, height, entry.rect.left, entry.rect.top);
+
+    page.packer.free(IntRect(entry.rect.left, entry.rect.top, width + padding, height + padding));
+
+    entry.used = false;
+    entry.generation++;
+    m_freeSlots.push_back(slot);
+    --m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        delete *it;
+
+    m_pages.clear();
+
+    // Keep the generations, handles given before must stay invalid
+    m_freeSlots.clear();
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].used)
+        {
+            m_entries[i].used = false;
+            m_entries[i].generation++;
+        }
+
+        m_freeSlots.push_back(i);
+    }
+
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::contains(Handle handle) const
+{
+    return findEntry(handle) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(Handle handle) const
+{
+    const Entry* entry = findEntry(handle);
+    assert(entry);
+
+    return m_pages[entry->page]->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureAtlas::getTextureRect(Handle handle) const
+{
+    const Entry* entry = findEntry(handle);
+
+    return entry ? entry->rect : IntRect();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getImageCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPageTexture(std::size_t index) const
+{
+    assert(index < m_pages.size());
+
+    return m_pages[index]->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextureAtlas::getOccupancy() const
+{
+    Uint64 total = 0;
+    Uint64 used = 0;
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        Vector2u size = m_pages[i]->packer.getSize();
+        total += static_cast<Uint64>(size.x) * size.y;
+    }
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].used)
+            used += static_cast<Uint64>(m_entries[i].rect.width) * m_entries[i].rect.height;
+    }
+
+    return total ? static_cast<float>(used) / total : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        (*it)->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+const TextureAtlas::Entry* TextureAtlas::findEntry(Handle handle) const
+{
+    std::size_t slot = static_cast<std::size_t>(handle & 0xFFFFFFFF);
+    Uint32 generation = static_cast<Uint32>(handle >> 32);
+
+    if ((slot == 0) || (slot > m_entries.size()))
+        return NULL;
+
+    const Entry& entry = m_entries[slot - 1];
+    if (!entry.used || (entry.generation != generation))
+        return NULL;
+
+    return &entry;
+}
+
+} // namespace sf
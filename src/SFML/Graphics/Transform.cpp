@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Simd.hpp>
 #include <cmath>
 
 
@@ -109,6 +110,95 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const
+{
+    transformPoints(input, sizeof(Vector2f), output, sizeof(Vector2f), count);
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* input, std::size_t inputStride,
+                                Vector2f* output, std::size_t outputStride, std::size_t count) const
+{
+    const char* in = reinterpret_cast<const char*>(input);
+    char* out = reinterpret_cast<char*>(output);
+    std::size_t i = 0;
+
+#if defined(SFML_SIMD_SSE2)
+
+    // Two points are transformed at once, so the columns of the matrix are duplicated
+    const __m128 column0 = _mm_setr_ps(m_matrix[0], m_matrix[1], m_matrix[0], m_matrix[1]);
+    const __m128 column1 = _mm_setr_ps(m_matrix[4], m_matrix[5], m_matrix[4], m_matrix[5]);
+    const __m128 column3 = _mm_setr_ps(m_matrix[12], m_matrix[13], m_matrix[12], m_matrix[13]);
+
+    const bool packed = (inputStride == sizeof(Vector2f)) && (outputStride == sizeof(Vector2f));
+
+    for (; i + 2 <= count; i += 2)
+    {
+        // Load (x0, y0, x1, y1)
+        __m128 points;
+        if (packed)
+        {
+            points = _mm_loadu_ps(reinterpret_cast<const float*>(in));
+        }
+        else
+        {
+            points = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in));
+            points = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(in + inputStride));
+        }
+
+        // Same operations, in the same order, as transformPoint
+        __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, x), _mm_mul_ps(column1, y)), column3);
+
+        if (packed)
+        {
+            _mm_storeu_ps(reinterpret_cast<float*>(out), result);
+        }
+        else
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(out), result);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(out + outputStride), result);
+        }
+
+        in  += 2 * inputStride;
+        out += 2 * outputStride;
+    }
+
+#elif defined(SFML_SIMD_NEON)
+
+    const float columns[] = {m_matrix[0], m_matrix[1], m_matrix[4], m_matrix[5], m_matrix[12], m_matrix[13]};
+    const float32x2_t column0 = vld1_f32(columns + 0);
+    const float32x2_t column1 = vld1_f32(columns + 2);
+    const float32x2_t column3 = vld1_f32(columns + 4);
+
+    for (; i < count; ++i)
+    {
+        // Same operations, in the same order, as transformPoint
+        float32x2_t point = vld1_f32(reinterpret_cast<const float*>(in));
+        float32x2_t result = vadd_f32(vmul_lane_f32(column0, point, 0), vmul_lane_f32(column1, point, 1));
+        vst1_f32(reinterpret_cast<float*>(out), vadd_f32(result, column3));
+
+        in  += inputStride;
+        out += outputStride;
+    }
+
+#endif
+
+    // Remaining points
+    for (; i < count; ++i)
+    {
+        const Vector2f point = *reinterpret_cast<const Vector2f*>(in);
+        *reinterpret_cast<Vector2f*>(out) = transformPoint(point.x, point.y);
+
+        in  += inputStride;
+        out += outputStride;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
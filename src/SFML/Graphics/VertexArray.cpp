@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Simd.hpp>
 
 
 namespace sf
@@ -112,8 +113,58 @@ FloatRect VertexArray::getBounds() const
         float top    = m_vertices[0].position.y;
         float right  = m_vertices[0].position.x;
         float bottom = m_vertices[0].position.y;
+        std::size_t i = 1;
 
-        for (std::size_t i = 1; i < m_vertices.size(); ++i)
+    #if defined(SFML_SIMD_SSE2)
+
+        // Process two positions at once: (x0, y0, x1, y1)
+        __m128 minimum = _mm_setr_ps(left, top, left, top);
+        __m128 maximum = minimum;
+
+        for (; i + 2 <= m_vertices.size(); i += 2)
+        {
+            __m128 positions = _mm_loadl_pi(minimum, reinterpret_cast<const __m64*>(&m_vertices[i].position));
+            positions = _mm_loadh_pi(positions, reinterpret_cast<const __m64*>(&m_vertices[i + 1].position));
+
+            minimum = _mm_min_ps(minimum, positions);
+            maximum = _mm_max_ps(maximum, positions);
+        }
+
+        // Merge the two halves
+        minimum = _mm_min_ps(minimum, _mm_movehl_ps(minimum, minimum));
+        maximum = _mm_max_ps(maximum, _mm_movehl_ps(maximum, maximum));
+
+        float bounds[4];
+        _mm_storel_pi(reinterpret_cast<__m64*>(bounds + 0), minimum);
+        _mm_storel_pi(reinterpret_cast<__m64*>(bounds + 2), maximum);
+        left   = bounds[0];
+        top    = bounds[1];
+        right  = bounds[2];
+        bottom = bounds[3];
+
+    #elif defined(SFML_SIMD_NEON)
+
+        // Process one position at a time: (x, y)
+        const float first[] = {left, top};
+        float32x2_t minimum = vld1_f32(first);
+        float32x2_t maximum = minimum;
+
+        for (; i < m_vertices.size(); ++i)
+        {
+            float32x2_t position = vld1_f32(&m_vertices[i].position.x);
+
+            minimum = vmin_f32(minimum, position);
+            maximum = vmax_f32(maximum, position);
+        }
+
+        left   = vget_lane_f32(minimum, 0);
+        top    = vget_lane_f32(minimum, 1);
+        right  = vget_lane_f32(maximum, 0);
+        bottom = vget_lane_f32(maximum, 1);
+
+    #endif
+
+        for (; i < m_vertices.size(); ++i)
         {
             Vector2f position = m_vertices[i].position;
 
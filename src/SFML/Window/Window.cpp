@@ -363,6 +363,9 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
+    // Let the derived classes finish the current frame
+    onDisplay();
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
@@ -397,6 +400,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {